@@ -1,5 +1,6 @@
 #pragma once
 #include "engine/assets/asset_handle.h"
+#include "engine/core/debugger/memory_tracker.h"
 #include "engine/math/geomath.h"
 #include "engine/renderer/gpu_resource.h"
 
@@ -40,7 +41,7 @@ using OnAssetLoadSuccessFunc = void (*)(IAsset* p_asset, void* p_userdata);
 struct BufferAsset : IAsset {
     BufferAsset() : IAsset(AssetType::BUFFER) {}
 
-    std::vector<char> buffer;
+    memory::TaggedVector<char, memory::MEMORY_TAG_ASSET> buffer;
 };
 
 struct TextAsset : IAsset {
@@ -56,7 +57,7 @@ struct ImageAsset : IAsset {
     int width = 0;
     int height = 0;
     int num_channels = 0;
-    std::vector<uint8_t> buffer;
+    memory::TaggedVector<uint8_t, memory::MEMORY_TAG_ASSET> buffer;
 
     // @TODO: refactor
     std::shared_ptr<GpuTexture> gpu_texture;
@@ -1,4 +1,5 @@
 #pragma once
+#include "engine/core/string/string_id.h"
 
 namespace my {
 
@@ -9,7 +10,17 @@ struct AssetHandle {
 #if USING(DEBUG_BUILD)
         path = p_path;
 #endif
-        hash = std::hash<std::string>()(p_path);
+        hash = static_cast<size_t>(HashString(p_path));
+    }
+
+    // same hash as the path it was made from, hashed at compile time for literals:
+    //   static constexpr StringId s_path("@res://images/brdf.hdr");
+    // the debug path is empty unless the id was interned
+    explicit AssetHandle(StringId p_path) {
+#if USING(DEBUG_BUILD)
+        path = p_path.GetString();
+#endif
+        hash = static_cast<size_t>(p_path.GetHash());
     }
 
     bool operator==(const AssetHandle& p_rhs) const {
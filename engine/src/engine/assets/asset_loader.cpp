@@ -50,11 +50,9 @@ auto BufferAssetLoader::Load() -> Result<IAsset*> {
 
     const size_t size = file_access->GetLength();
 
-    std::vector<char> buffer;
-    buffer.resize(size);
-    file_access->ReadBuffer(buffer.data(), size);
     auto file = new BufferAsset;
-    file->buffer = std::move(buffer);
+    file->buffer.resize(size);
+    file_access->ReadBuffer(file->buffer.data(), size);
     return file;
 }
 
@@ -141,7 +139,7 @@ auto ImageAssetLoader::Load() -> Result<IAsset*> {
     const uint32_t pixel_size = is_float ? sizeof(float) : sizeof(uint8_t);
 
     int num_pixels = width * height * num_channels;
-    std::vector<uint8_t> buffer;
+    decltype(ImageAsset::buffer) buffer;
     buffer.resize(pixel_size * num_pixels);
     memcpy(buffer.data(), pixels, pixel_size * num_pixels);
     stbi_image_free(pixels);
@@ -0,0 +1,64 @@
+#pragma once
+
+#if USING(ARCH_X64)
+#include <immintrin.h>
+#endif
+
+namespace my {
+
+inline void CpuRelax() {
+#if USING(ARCH_X64)
+    _mm_pause();
+#elif defined(_MSC_VER)
+    __yield();
+#else
+    __builtin_arm_yield();
+#endif
+}
+
+// Spins with a growing number of cpu pauses, then yields the time slice. Once both are exhausted Pause()
+// returns false and the caller should block, usually on std::atomic::wait().
+class Backoff {
+public:
+    static constexpr int SPIN_STEPS = 10;
+    static constexpr int YIELD_STEPS = 8;
+
+    bool Pause() {
+        if (m_step < SPIN_STEPS) {
+            // 1, 2, 4 ... 64 pauses, then stays there
+            const int count = 1 << std::min(m_step, 6);
+            for (int i = 0; i < count; ++i) {
+                CpuRelax();
+            }
+        } else if (m_step < SPIN_STEPS + YIELD_STEPS) {
+            std::this_thread::yield();
+        } else {
+            return false;
+        }
+
+        ++m_step;
+        return true;
+    }
+
+    void Reset() { m_step = 0; }
+
+private:
+    int m_step = 0;
+};
+
+// Blocks until p_done(value) holds, spinning then yielding before parking on the atomic. Whoever changes
+// the atomic in a way that can satisfy p_done has to notify it.
+template<typename T, typename PRED>
+T WaitUntil(const std::atomic<T>& p_atomic, PRED&& p_done) {
+    Backoff backoff;
+    T value = p_atomic.load(std::memory_order_acquire);
+    while (!p_done(value)) {
+        if (!backoff.Pause()) {
+            p_atomic.wait(value, std::memory_order_acquire);
+        }
+        value = p_atomic.load(std::memory_order_acquire);
+    }
+    return value;
+}
+
+}  // namespace my
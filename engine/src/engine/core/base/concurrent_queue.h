@@ -2,42 +2,209 @@
 
 namespace my {
 
-// @TODO: check out implmentation here
-// https://github.com/supermartian/lockfree-queue/tree/master
-// https://people.cs.pitt.edu/~jacklange/teaching/cs2510-f12/papers/implementing_lock_free.pdf
+// Unbounded multi-producer multi-consumer queue, values live in a linked list of fixed size segments.
+// Producers claim a cell with an atomic increment of the segment tail, consumers with a CAS on the
+// segment head, nobody takes a lock. A segment is only written once, when it's full producers move on
+// to the next one, and the consumer that moves past it retires it.
+// Retired segments are freed by the last thread leaving the queue, so a thread that still holds a
+// pointer to one never reads freed memory.
+// pop() and pop_all() stop at a value that is still being pushed, the values behind it show up once the
+// push finished.
 template<typename T>
 class ConcurrentQueue {
+    static constexpr uint32_t SEGMENT_SIZE = 64;
+
+    struct Cell {
+        std::atomic_bool ready{ false };
+        T value;
+    };
+
+    struct Segment {
+        alignas(64) std::atomic_uint32_t head{ 0 };
+        alignas(64) std::atomic_uint32_t tail{ 0 };
+        std::atomic<Segment*> next{ nullptr };
+        Segment* nextRetired{ nullptr };
+        std::array<Cell, SEGMENT_SIZE> cells;
+    };
+
+    // counts the threads inside the queue, see LeaveOperation()
+    class OperationScope {
+    public:
+        explicit OperationScope(ConcurrentQueue& p_queue) : m_queue(p_queue) {
+            m_queue.m_activeOperations.fetch_add(1);
+        }
+
+        ~OperationScope() { m_queue.LeaveOperation(); }
+
+    private:
+        ConcurrentQueue& m_queue;
+    };
+
 public:
+    ConcurrentQueue() {
+        Segment* segment = new Segment;
+        m_head.store(segment);
+        m_tail.store(segment);
+    }
+
+    ~ConcurrentQueue() {
+        FreeSegments(m_retired.load());
+        for (Segment* segment = m_head.load(); segment;) {
+            Segment* next = segment->next.load();
+            delete segment;
+            segment = next;
+        }
+    }
+
+    ConcurrentQueue(const ConcurrentQueue&) = delete;
+    ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+
     void push(const T& p_value) {
-        m_mutex.lock();
-        m_queue.emplace(p_value);
-        m_mutex.unlock();
+        OperationScope scope(*this);
+
+        for (;;) {
+            Segment* segment = m_tail.load();
+            // can go past the end when the segment is full, no harm done
+            const uint32_t index = segment->tail.fetch_add(1);
+            if (index < SEGMENT_SIZE) {
+                Cell& cell = segment->cells[index];
+                cell.value = p_value;
+                cell.ready.store(true, std::memory_order_release);
+                return;
+            }
+
+            Segment* next = segment->next.load();
+            if (!next) {
+                Segment* new_segment = new Segment;
+                if (segment->next.compare_exchange_strong(next, new_segment)) {
+                    next = new_segment;
+                } else {
+                    delete new_segment;
+                }
+            }
+            m_tail.compare_exchange_strong(segment, next);
+        }
     }
 
     bool pop(T& p_out_value) {
-        std::lock_guard guard(m_mutex);
-        if (m_queue.empty()) {
-            return false;
-        }
+        OperationScope scope(*this);
 
-        p_out_value = std::move(m_queue.front());
-        m_queue.pop();
-        return true;
+        for (;;) {
+            Segment* segment = m_head.load();
+            uint32_t index = segment->head.load();
+            if (index < SEGMENT_SIZE) {
+                Cell& cell = segment->cells[index];
+                if (!cell.ready.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                if (segment->head.compare_exchange_weak(index, index + 1)) {
+                    p_out_value = std::move(cell.value);
+                    return true;
+                }
+                continue;
+            }
+
+            if (!AdvanceHead(segment)) {
+                return false;
+            }
+        }
     }
 
+    // takes everything that's ready, claiming the values of a segment with a single CAS
     std::queue<T> pop_all() {
+        OperationScope scope(*this);
+
         std::queue<T> ret;
-        m_mutex.lock();
-        if (!m_queue.empty()) {
-            m_queue.swap(ret);
+        for (;;) {
+            Segment* segment = m_head.load();
+            uint32_t index = segment->head.load();
+            if (index < SEGMENT_SIZE) {
+                uint32_t end = index;
+                while (end < SEGMENT_SIZE && segment->cells[end].ready.load(std::memory_order_acquire)) {
+                    ++end;
+                }
+                if (end == index) {
+                    return ret;
+                }
+                if (!segment->head.compare_exchange_weak(index, end)) {
+                    continue;
+                }
+
+                for (; index < end; ++index) {
+                    ret.emplace(std::move(segment->cells[index].value));
+                }
+                if (end < SEGMENT_SIZE) {
+                    return ret;
+                }
+            }
+
+            if (!AdvanceHead(segment)) {
+                return ret;
+            }
         }
-        m_mutex.unlock();
-        return ret;
     }
 
 private:
-    std::queue<T> m_queue;
-    mutable std::mutex m_mutex;
+    // Called once every cell of p_segment has been claimed by a consumer, returns false if there's no
+    // segment after it. The tail is moved past p_segment first, so no new thread can find it.
+    bool AdvanceHead(Segment* p_segment) {
+        Segment* next = p_segment->next.load();
+        if (!next) {
+            return false;
+        }
+
+        Segment* expected = p_segment;
+        m_tail.compare_exchange_strong(expected, next);
+        expected = p_segment;
+        if (m_head.compare_exchange_strong(expected, next)) {
+            Retire(p_segment);
+        }
+        return true;
+    }
+
+    void Retire(Segment* p_segment) { PushRetired(p_segment, p_segment); }
+
+    void PushRetired(Segment* p_first, Segment* p_last) {
+        Segment* head = m_retired.load();
+        do {
+            p_last->nextRetired = head;
+        } while (!m_retired.compare_exchange_weak(head, p_first));
+    }
+
+    // A retired segment can only be reached by the threads that were inside the queue when it was
+    // retired. So once a thread leaving the queue is the only one left in it, every segment retired
+    // before it took the list can go.
+    void LeaveOperation() {
+        if (m_retired.load()) {
+            Segment* retired = m_retired.exchange(nullptr);
+            if (retired) {
+                if (m_activeOperations.load() == 1) {
+                    FreeSegments(retired);
+                } else {
+                    Segment* last = retired;
+                    while (last->nextRetired) {
+                        last = last->nextRetired;
+                    }
+                    PushRetired(retired, last);
+                }
+            }
+        }
+
+        m_activeOperations.fetch_sub(1);
+    }
+
+    static void FreeSegments(Segment* p_list) {
+        while (p_list) {
+            Segment* next = p_list->nextRetired;
+            delete p_list;
+            p_list = next;
+        }
+    }
+
+    alignas(64) std::atomic<Segment*> m_head{ nullptr };
+    alignas(64) std::atomic<Segment*> m_tail{ nullptr };
+    alignas(64) std::atomic_int m_activeOperations{ 0 };
+    std::atomic<Segment*> m_retired{ nullptr };
 };
 
 }  // namespace my
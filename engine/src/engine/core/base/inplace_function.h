@@ -0,0 +1,102 @@
+#pragma once
+
+namespace my {
+
+template<typename SIGNATURE, size_t CAPACITY>
+class InplaceFunction;
+
+// A std::function that never allocates. The callable is stored inline, captures that don't fit in
+// CAPACITY bytes fail to compile instead of falling back to the heap.
+template<typename R, typename... Args, size_t CAPACITY>
+class InplaceFunction<R(Args...), CAPACITY> {
+    static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+
+    using InvokeFunc = R (*)(void*, Args&&...);
+    // moves p_source into p_dest if p_source is not null, destroys p_dest otherwise
+    using ManageFunc = void (*)(void* p_dest, void* p_source);
+
+    template<typename FUNC>
+    static constexpr bool IS_CALLABLE = std::is_invocable_r_v<R, FUNC&, Args...> &&
+                                        !std::is_same_v<std::decay_t<FUNC>, InplaceFunction>;
+
+public:
+    InplaceFunction() = default;
+
+    InplaceFunction(std::nullptr_t) {}
+
+    template<typename FUNC>
+        requires IS_CALLABLE<FUNC>
+    InplaceFunction(FUNC&& p_func) {
+        using T = std::decay_t<FUNC>;
+        static_assert(sizeof(T) <= CAPACITY, "captures don't fit in InplaceFunction, capture a pointer or a reference instead");
+        static_assert(alignof(T) <= ALIGNMENT, "callable is over aligned");
+        static_assert(std::is_nothrow_move_constructible_v<T>, "callable must be nothrow move constructible");
+
+        new (m_storage) T(std::forward<FUNC>(p_func));
+        m_invoke = [](void* p_object, Args&&... p_args) -> R {
+            return (*static_cast<T*>(p_object))(std::forward<Args>(p_args)...);
+        };
+        m_manage = [](void* p_dest, void* p_source) {
+            if (p_source) {
+                new (p_dest) T(std::move(*static_cast<T*>(p_source)));
+                static_cast<T*>(p_source)->~T();
+            } else {
+                static_cast<T*>(p_dest)->~T();
+            }
+        };
+    }
+
+    InplaceFunction(InplaceFunction&& p_other) noexcept { MoveFrom(p_other); }
+
+    InplaceFunction& operator=(InplaceFunction&& p_other) noexcept {
+        if (this != &p_other) {
+            Reset();
+            MoveFrom(p_other);
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(std::nullptr_t) {
+        Reset();
+        return *this;
+    }
+
+    InplaceFunction(const InplaceFunction&) = delete;
+    InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+    ~InplaceFunction() { Reset(); }
+
+    R operator()(Args... p_args) const {
+        DEV_ASSERT(m_invoke);
+        return m_invoke(const_cast<std::byte*>(m_storage), std::forward<Args>(p_args)...);
+    }
+
+    explicit operator bool() const { return m_invoke != nullptr; }
+
+    static constexpr size_t capacity() { return CAPACITY; }
+
+private:
+    void Reset() {
+        if (m_manage) {
+            m_manage(m_storage, nullptr);
+        }
+        m_invoke = nullptr;
+        m_manage = nullptr;
+    }
+
+    void MoveFrom(InplaceFunction& p_other) {
+        if (p_other.m_manage) {
+            p_other.m_manage(m_storage, p_other.m_storage);
+        }
+        m_invoke = p_other.m_invoke;
+        m_manage = p_other.m_manage;
+        p_other.m_invoke = nullptr;
+        p_other.m_manage = nullptr;
+    }
+
+    alignas(ALIGNMENT) std::byte m_storage[CAPACITY];
+    InvokeFunc m_invoke = nullptr;
+    ManageFunc m_manage = nullptr;
+};
+
+}  // namespace my
@@ -0,0 +1,85 @@
+#include "linear_arena.h"
+
+namespace my {
+
+LinearArena::~LinearArena() {
+    memory::TrackDeallocation(m_tag, GetCapacity());
+}
+
+void LinearArena::Reset() {
+    m_currentBlock = 0;
+    m_usedBefore = 0;
+    if (m_blocks.empty()) {
+        m_cursor = nullptr;
+        m_end = nullptr;
+        return;
+    }
+
+    m_cursor = m_blocks[0].memory.get();
+    m_end = m_cursor + m_blocks[0].size;
+}
+
+void LinearArena::Rewind(const Marker& p_marker) {
+    // taken before the first allocation
+    if (!p_marker.cursor) {
+        Reset();
+        return;
+    }
+
+    DEV_ASSERT(p_marker.block <= m_currentBlock);
+    const Block& block = m_blocks[p_marker.block];
+    DEV_ASSERT(p_marker.cursor >= block.memory.get() && p_marker.cursor <= block.memory.get() + block.size);
+
+    m_currentBlock = p_marker.block;
+    m_usedBefore = p_marker.usedBefore;
+    m_cursor = p_marker.cursor;
+    m_end = block.memory.get() + block.size;
+}
+
+size_t LinearArena::GetUsedSize() const {
+    if (m_blocks.empty()) {
+        return 0;
+    }
+    return m_usedBefore + static_cast<size_t>(m_cursor - m_blocks[m_currentBlock].memory.get());
+}
+
+size_t LinearArena::GetCapacity() const {
+    size_t capacity = 0;
+    for (const Block& block : m_blocks) {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+void* LinearArena::AllocateSlow(size_t p_size, size_t p_alignment) {
+    // worst case padding, the blocks are only aligned to max_align_t
+    const size_t needed = p_size + p_alignment;
+
+    if (!m_blocks.empty()) {
+        m_usedBefore += static_cast<size_t>(m_cursor - m_blocks[m_currentBlock].memory.get());
+        ++m_currentBlock;
+    }
+
+    // blocks kept from the last rounds come first, the ones too small for this allocation stay unused
+    // until the next reset
+    while (m_currentBlock < m_blocks.size() && m_blocks[m_currentBlock].size < needed) {
+        ++m_currentBlock;
+    }
+
+    if (m_currentBlock == m_blocks.size()) {
+        const size_t size = std::max(m_blockSize, needed);
+        memory::TrackAllocation(m_tag, size);
+        // left uninitialized, whatever lives in it gets constructed anyway
+        m_blocks.push_back({ std::unique_ptr<std::byte[]>(new std::byte[size]), size });
+    }
+
+    Block& block = m_blocks[m_currentBlock];
+    m_cursor = block.memory.get();
+    m_end = m_cursor + block.size;
+
+    void* result = Allocate(p_size, p_alignment);
+    DEV_ASSERT(result);
+    return result;
+}
+
+}  // namespace my
@@ -0,0 +1,110 @@
+#pragma once
+#include "engine/core/debugger/memory_tracker.h"
+
+#include "noncopyable.h"
+
+namespace my {
+
+// Bump allocator. Memory is handed out from big blocks and only given back all at once by Reset(), which
+// keeps the blocks for the next round. Nothing allocated from the arena is ever destroyed by it, objects that
+// own memory elsewhere have to be destroyed by hand before the reset.
+class LinearArena : public NonCopyable {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 1 << 20;
+
+    // the blocks are counted into p_tag
+    explicit LinearArena(size_t p_block_size = DEFAULT_BLOCK_SIZE, memory::MemoryTag p_tag = memory::MEMORY_TAG_GENERAL)
+        : m_blockSize(p_block_size),
+          m_tag(p_tag) {}
+
+    ~LinearArena();
+
+    void* Allocate(size_t p_size, size_t p_alignment = alignof(std::max_align_t)) {
+        const uintptr_t cursor = (reinterpret_cast<uintptr_t>(m_cursor) + p_alignment - 1) & ~(p_alignment - 1);
+        if (m_cursor && cursor + p_size <= reinterpret_cast<uintptr_t>(m_end)) {
+            m_cursor = reinterpret_cast<std::byte*>(cursor + p_size);
+            return reinterpret_cast<void*>(cursor);
+        }
+        return AllocateSlow(p_size, p_alignment);
+    }
+
+    template<typename T, typename... Args>
+    T* New(Args&&... p_args) {
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(p_args)...);
+    }
+
+    template<typename T>
+    T* AllocateArray(size_t p_count) {
+        return static_cast<T*>(Allocate(sizeof(T) * p_count, alignof(T)));
+    }
+
+    // position in the arena, everything allocated after it is given back by Rewind()
+    struct Marker {
+        size_t block;
+        size_t usedBefore;
+        std::byte* cursor;
+    };
+
+    Marker GetMarker() const { return { m_currentBlock, m_usedBefore, m_cursor }; }
+
+    // O(1), the blocks after the marker are kept for the next allocations
+    void Rewind(const Marker& p_marker);
+
+    // O(1), starts over from the first block
+    void Reset();
+
+    // bytes handed out since the last reset, padding included
+    size_t GetUsedSize() const;
+
+    size_t GetCapacity() const;
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> memory;
+        size_t size;
+    };
+
+    void* AllocateSlow(size_t p_size, size_t p_alignment);
+
+    const size_t m_blockSize;
+    const memory::MemoryTag m_tag;
+    std::vector<Block> m_blocks;
+    size_t m_currentBlock = 0;
+    // used size of the blocks before the current one
+    size_t m_usedBefore = 0;
+    std::byte* m_cursor = nullptr;
+    std::byte* m_end = nullptr;
+};
+
+// Lets the std containers allocate from an arena. Deallocation is a no-op, memory a container lets go of is
+// only reused after the reset, so reserve() what you can.
+template<typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator(LinearArena& p_arena) : m_arena(&p_arena) {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& p_other) : m_arena(p_other.GetArena()) {}
+
+    T* allocate(size_t p_count) { return m_arena->AllocateArray<T>(p_count); }
+
+    void deallocate(T*, size_t) {}
+
+    LinearArena* GetArena() const { return m_arena; }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& p_other) const { return m_arena == p_other.GetArena(); }
+
+private:
+    LinearArena* m_arena;
+};
+
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+template<typename KEY, typename VALUE, typename HASH = std::hash<KEY>>
+using ArenaUnorderedMap = std::unordered_map<KEY, VALUE, HASH, std::equal_to<KEY>, ArenaAllocator<std::pair<const KEY, VALUE>>>;
+
+}  // namespace my
@@ -0,0 +1,98 @@
+#pragma once
+
+namespace my {
+
+// Bounded multi-producer multi-consumer queue, see
+// https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+// Every cell carries a sequence number telling whose turn it is, producers and consumers claim a cell with
+// a single CAS on the tail or the head, and only ever contend with their own kind.
+// Same interface as ThreadSafeRingBuffer, push_back() returns false when full, pop_front() when empty.
+template<typename T, size_t N>
+class MpmcRingBuffer {
+    static_assert(N > 1 && (N & (N - 1)) == 0, "capacity must be power of two");
+    static constexpr size_t MASK = N - 1;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+public:
+    MpmcRingBuffer() {
+        for (size_t i = 0; i < N; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcRingBuffer(const MpmcRingBuffer&) = delete;
+    MpmcRingBuffer& operator=(const MpmcRingBuffer&) = delete;
+
+    bool push_back(const T& p_value) {
+        Cell* cell = nullptr;
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &m_cells[pos & MASK];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                // the cell is free, try to claim it
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // the cell still holds the value from the previous lap
+                return false;
+            } else {
+                // an other producer got there first
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = p_value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop_front(T& p_out_value) {
+        Cell* cell = nullptr;
+        size_t pos = m_head.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &m_cells[pos & MASK];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // nothing was written to the cell yet
+                return false;
+            } else {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+
+        p_out_value = std::move(cell->data);
+        // free the cell for the producer of the next lap
+        cell->sequence.store(pos + N, std::memory_order_release);
+        return true;
+    }
+
+    // only a snapshot when other threads are pushing or popping
+    size_t size() const {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    constexpr size_t capacity() const { return N; }
+
+private:
+    alignas(64) std::atomic<size_t> m_head{ 0 };
+    alignas(64) std::atomic<size_t> m_tail{ 0 };
+    alignas(64) std::array<Cell, N> m_cells;
+};
+
+}  // namespace my
@@ -3,7 +3,7 @@
 
 namespace my {
 
-// @TODO: change to atomic int implementation
+// MpmcRingBuffer has the same interface without the lock
 template<typename T, size_t N>
 struct ThreadSafeRingBuffer {
     RingBuffer<T, N> m_ring_buffer;
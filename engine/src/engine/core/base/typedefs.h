@@ -18,9 +18,15 @@
 #if defined(WIN32) || defined(_WIN32)
 #define PLATFORM_WINDOWS IN_USE
 #define PLATFORM_APPLE   NOT_IN_USE
+#define PLATFORM_LINUX   NOT_IN_USE
 #elif defined(__APPLE__)
 #define PLATFORM_WINDOWS NOT_IN_USE
 #define PLATFORM_APPLE   IN_USE
+#define PLATFORM_LINUX   NOT_IN_USE
+#elif defined(__linux__)
+#define PLATFORM_WINDOWS NOT_IN_USE
+#define PLATFORM_APPLE   NOT_IN_USE
+#define PLATFORM_LINUX   IN_USE
 #else
 #error Platform not supported!
 #endif
@@ -62,7 +68,7 @@
 
 #if USING(PLATFORM_WINDOWS)
 #define GENERATE_TRAP() __debugbreak()
-#elif USING(PLATFORM_APPLE)
+#elif USING(PLATFORM_APPLE) || USING(PLATFORM_LINUX)
 #define GENERATE_TRAP() __builtin_trap()
 #else
 #error Platform not supported
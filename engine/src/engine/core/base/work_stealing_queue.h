@@ -0,0 +1,98 @@
+#pragma once
+
+namespace my {
+
+// Chase-Lev work stealing deque, see
+// https://www.di.ens.fr/~zappa/readings/ppopp13.pdf
+// The owner thread pushes and pops at the bottom, any other thread can steal from the top.
+// The capacity is fixed, push() returns false when the queue is full.
+template<typename T, size_t N>
+    requires std::is_trivially_copyable_v<T>
+class WorkStealingQueue {
+    static_assert(N > 1 && (N & (N - 1)) == 0, "capacity must be power of two");
+    static constexpr int64_t MASK = static_cast<int64_t>(N) - 1;
+
+public:
+    // owner only
+    bool push(const T& p_value) {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        const int64_t top = m_top.load(std::memory_order_acquire);
+        if (bottom - top >= static_cast<int64_t>(N)) {
+            return false;
+        }
+
+        m_data[bottom & MASK].store(p_value, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // owner only
+    bool pop(T& p_out_value) {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            // empty
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        p_out_value = m_data[bottom & MASK].load(std::memory_order_relaxed);
+        if (top != bottom) {
+            return true;
+        }
+
+        // last element, race against thieves
+        const bool won = m_top.compare_exchange_strong(top,
+                                                       top + 1,
+                                                       std::memory_order_seq_cst,
+                                                       std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    // any thread
+    bool steal(T& p_out_value) {
+        int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return false;
+        }
+
+        T value = m_data[top & MASK].load(std::memory_order_relaxed);
+        if (!m_top.compare_exchange_strong(top,
+                                           top + 1,
+                                           std::memory_order_seq_cst,
+                                           std::memory_order_relaxed)) {
+            return false;
+        }
+
+        p_out_value = value;
+        return true;
+    }
+
+    bool empty() const {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        const int64_t top = m_top.load(std::memory_order_relaxed);
+        return bottom <= top;
+    }
+
+    size_t size() const {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        const int64_t top = m_top.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+    constexpr size_t capacity() const { return N; }
+
+private:
+    alignas(64) std::atomic<int64_t> m_top{ 0 };
+    alignas(64) std::atomic<int64_t> m_bottom{ 0 };
+    alignas(64) std::array<std::atomic<T>, N> m_data;
+};
+
+}  // namespace my
@@ -0,0 +1,180 @@
+#include "memory_tracker.h"
+
+namespace my::memory {
+
+namespace {
+
+struct TagState {
+    std::atomic_int64_t currentBytes{ 0 };
+    std::atomic_int64_t peakBytes{ 0 };
+    std::atomic_uint64_t allocationCount{ 0 };
+    std::atomic_uint64_t allocatedBytes{ 0 };
+
+    std::atomic_uint64_t budget{ 0 };
+    std::atomic<BudgetAction> budgetAction{ BudgetAction::LOG };
+    std::atomic_bool overBudget{ false };
+
+    // written by UpdateStats()
+    std::atomic<double> allocationRate{ 0.0 };
+    uint64_t lastAllocatedBytes{ 0 };
+};
+
+// Only touched by the owning thread, published to the tag states in batches. Trivially destructible, so
+// thread_local arenas destroyed after the exit hook (and static ones, at exit) can still count into it.
+struct ThreadCounters {
+    struct Pending {
+        int64_t bytes = 0;
+        uint64_t allocationCount = 0;
+        uint64_t allocatedBytes = 0;
+    };
+
+    std::array<Pending, MEMORY_TAG_COUNT> pending;
+    bool registered = false;
+    // the exit hook ran, everything counted from now on is published right away
+    bool exited = false;
+};
+
+// publishes what is left in the counters when the thread exits
+struct ThreadExit {
+    ~ThreadExit();
+};
+
+}  // namespace
+
+static struct {
+    std::array<TagState, MEMORY_TAG_COUNT> tags;
+    std::chrono::steady_clock::time_point lastUpdate;
+} s_glob;
+
+static thread_local ThreadCounters s_counters;
+
+static void CheckBudget(MemoryTag p_tag, int64_t p_current) {
+    TagState& state = s_glob.tags[p_tag];
+    const uint64_t budget = state.budget.load(std::memory_order_relaxed);
+    if (budget == 0) {
+        return;
+    }
+
+    if (p_current <= static_cast<int64_t>(budget)) {
+        // back under, report the next time it goes over
+        if (state.overBudget.load(std::memory_order_relaxed)) {
+            state.overBudget.store(false, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    if (state.overBudget.exchange(true, std::memory_order_relaxed)) {
+        return;
+    }
+
+    LOG_WARN("memory tag '{}' is over budget, {} of {} bytes", ToString(p_tag), p_current, budget);
+    if (state.budgetAction.load(std::memory_order_relaxed) == BudgetAction::ASSERT) {
+        DEV_ASSERT_MSG(p_current <= static_cast<int64_t>(budget), "memory budget exceeded");
+    }
+}
+
+static void Publish(MemoryTag p_tag, ThreadCounters::Pending& p_pending) {
+    TagState& state = s_glob.tags[p_tag];
+    const int64_t current = state.currentBytes.fetch_add(p_pending.bytes, std::memory_order_relaxed) + p_pending.bytes;
+    state.allocationCount.fetch_add(p_pending.allocationCount, std::memory_order_relaxed);
+    state.allocatedBytes.fetch_add(p_pending.allocatedBytes, std::memory_order_relaxed);
+    p_pending = ThreadCounters::Pending();
+
+    int64_t peak = state.peakBytes.load(std::memory_order_relaxed);
+    while (current > peak && !state.peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+
+    CheckBudget(p_tag, current);
+}
+
+ThreadExit::~ThreadExit() {
+    for (int tag = 0; tag < MEMORY_TAG_COUNT; ++tag) {
+        Publish(static_cast<MemoryTag>(tag), s_counters.pending[tag]);
+    }
+    s_counters.exited = true;
+}
+
+static ThreadCounters::Pending& GetPending(MemoryTag p_tag) {
+    if (!s_counters.registered) [[unlikely]] {
+        s_counters.registered = true;
+        // registered on first use, so it's destroyed before the thread_locals constructed earlier
+        static thread_local ThreadExit s_exit;
+        (void)s_exit;
+    }
+    return s_counters.pending[p_tag];
+}
+
+const char* ToString(MemoryTag p_tag) {
+    ERR_FAIL_INDEX_V(p_tag, MEMORY_TAG_COUNT, nullptr);
+    static constexpr const char* s_table[] = {
+#define MEMORY_TAG_DECLARE(ENUM, STR) STR,
+        MEMORY_TAG_LIST
+#undef MEMORY_TAG_DECLARE
+    };
+
+    return s_table[p_tag];
+}
+
+void TrackAllocation(MemoryTag p_tag, size_t p_bytes) {
+    DEV_ASSERT_INDEX(p_tag, MEMORY_TAG_COUNT);
+    ThreadCounters::Pending& pending = GetPending(p_tag);
+    pending.bytes += static_cast<int64_t>(p_bytes);
+    pending.allocatedBytes += p_bytes;
+    ++pending.allocationCount;
+    // allocatedBytes grows even when the memory is freed right away, so the rates keep publishing
+    if (pending.allocatedBytes >= PUBLISH_THRESHOLD || s_counters.exited) {
+        Publish(p_tag, pending);
+    }
+}
+
+void TrackDeallocation(MemoryTag p_tag, size_t p_bytes) {
+    DEV_ASSERT_INDEX(p_tag, MEMORY_TAG_COUNT);
+    // memory freed on another thread than the one that allocated it makes this go negative, the sum is right
+    ThreadCounters::Pending& pending = GetPending(p_tag);
+    pending.bytes -= static_cast<int64_t>(p_bytes);
+    if (pending.bytes <= -PUBLISH_THRESHOLD || s_counters.exited) {
+        Publish(p_tag, pending);
+    }
+}
+
+void SetBudget(MemoryTag p_tag, size_t p_bytes, BudgetAction p_action) {
+    ERR_FAIL_INDEX(p_tag, MEMORY_TAG_COUNT);
+    TagState& state = s_glob.tags[p_tag];
+    state.budgetAction.store(p_action, std::memory_order_relaxed);
+    state.budget.store(p_bytes, std::memory_order_relaxed);
+    state.overBudget.store(false, std::memory_order_relaxed);
+    CheckBudget(p_tag, state.currentBytes.load(std::memory_order_relaxed));
+}
+
+MemoryStats GetStats(MemoryTag p_tag) {
+    ERR_FAIL_INDEX_V(p_tag, MEMORY_TAG_COUNT, MemoryStats());
+    const TagState& state = s_glob.tags[p_tag];
+    return {
+        .currentBytes = state.currentBytes.load(std::memory_order_relaxed),
+        .peakBytes = state.peakBytes.load(std::memory_order_relaxed),
+        .allocationCount = state.allocationCount.load(std::memory_order_relaxed),
+        .allocationRate = state.allocationRate.load(std::memory_order_relaxed),
+        .overBudget = state.overBudget.load(std::memory_order_relaxed),
+    };
+}
+
+void UpdateStats() {
+    const auto now = std::chrono::steady_clock::now();
+    // the first call only takes the starting point
+    const bool first = s_glob.lastUpdate == std::chrono::steady_clock::time_point();
+    const double seconds = std::chrono::duration<double>(now - s_glob.lastUpdate).count();
+    if (!first && seconds <= 0.0) {
+        return;
+    }
+    s_glob.lastUpdate = now;
+
+    for (TagState& state : s_glob.tags) {
+        const uint64_t allocated = state.allocatedBytes.load(std::memory_order_relaxed);
+        if (!first) {
+            state.allocationRate.store(static_cast<double>(allocated - state.lastAllocatedBytes) / seconds, std::memory_order_relaxed);
+        }
+        state.lastAllocatedBytes = allocated;
+    }
+}
+
+}  // namespace my::memory
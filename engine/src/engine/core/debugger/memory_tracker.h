@@ -0,0 +1,112 @@
+#pragma once
+#include <memory_resource>
+
+namespace my::memory {
+
+#define MEMORY_TAG_LIST                                           \
+    MEMORY_TAG_DECLARE(MEMORY_TAG_GENERAL, "general")             \
+    MEMORY_TAG_DECLARE(MEMORY_TAG_ASSET, "asset")                 \
+    MEMORY_TAG_DECLARE(MEMORY_TAG_ECS, "ecs")                     \
+    MEMORY_TAG_DECLARE(MEMORY_TAG_RENDER_DATA, "render_data")     \
+    MEMORY_TAG_DECLARE(MEMORY_TAG_BVH, "bvh")                     \
+    MEMORY_TAG_DECLARE(MEMORY_TAG_SCRATCH, "scratch")             \
+    MEMORY_TAG_DECLARE(MEMORY_TAG_PHYSICS, "physics")             \
+    MEMORY_TAG_DECLARE(MEMORY_TAG_SCRIPT, "script")
+
+enum MemoryTag : uint8_t {
+#define MEMORY_TAG_DECLARE(ENUM, STR) ENUM,
+    MEMORY_TAG_LIST
+#undef MEMORY_TAG_DECLARE
+    MEMORY_TAG_COUNT,
+};
+
+const char* ToString(MemoryTag p_tag);
+
+enum class BudgetAction : uint8_t {
+    LOG,
+    ASSERT,
+};
+
+struct MemoryStats {
+    int64_t currentBytes;
+    int64_t peakBytes;
+    uint64_t allocationCount;
+    // bytes allocated per second between the last two UpdateStats()
+    double allocationRate;
+    bool overBudget;
+};
+
+// Each thread counts into its own counters and only publishes them once they add up to
+// PUBLISH_THRESHOLD bytes, so the stats and the budget checks lag behind by at most that much per thread.
+inline constexpr int64_t PUBLISH_THRESHOLD = 64 * 1024;
+
+void TrackAllocation(MemoryTag p_tag, size_t p_bytes);
+
+void TrackDeallocation(MemoryTag p_tag, size_t p_bytes);
+
+// Reported once every time the tag goes over it, p_bytes = 0 removes the budget
+void SetBudget(MemoryTag p_tag, size_t p_bytes, BudgetAction p_action = BudgetAction::LOG);
+
+MemoryStats GetStats(MemoryTag p_tag);
+
+// once per frame, samples the allocation rates
+void UpdateStats();
+
+// std allocator that counts into TAG, e.g. TaggedVector<Node, MEMORY_TAG_BVH>
+template<typename T, MemoryTag TAG>
+class TaggedAllocator {
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = TaggedAllocator<U, TAG>;
+    };
+
+    TaggedAllocator() = default;
+
+    template<typename U>
+    TaggedAllocator(const TaggedAllocator<U, TAG>&) {}
+
+    T* allocate(size_t p_count) {
+        TrackAllocation(TAG, sizeof(T) * p_count);
+        return std::allocator<T>().allocate(p_count);
+    }
+
+    void deallocate(T* p_ptr, size_t p_count) {
+        TrackDeallocation(TAG, sizeof(T) * p_count);
+        std::allocator<T>().deallocate(p_ptr, p_count);
+    }
+
+    template<typename U>
+    bool operator==(const TaggedAllocator<U, TAG>&) const { return true; }
+};
+
+template<typename T, MemoryTag TAG>
+using TaggedVector = std::vector<T, TaggedAllocator<T, TAG>>;
+
+// counts everything passing through to the upstream resource
+class TaggedMemoryResource : public std::pmr::memory_resource {
+public:
+    TaggedMemoryResource(MemoryTag p_tag, std::pmr::memory_resource* p_upstream = std::pmr::get_default_resource())
+        : m_tag(p_tag),
+          m_upstream(p_upstream) {}
+
+private:
+    void* do_allocate(size_t p_bytes, size_t p_alignment) override {
+        TrackAllocation(m_tag, p_bytes);
+        return m_upstream->allocate(p_bytes, p_alignment);
+    }
+
+    void do_deallocate(void* p_ptr, size_t p_bytes, size_t p_alignment) override {
+        TrackDeallocation(m_tag, p_bytes);
+        m_upstream->deallocate(p_ptr, p_bytes, p_alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& p_other) const noexcept override { return this == &p_other; }
+
+    const MemoryTag m_tag;
+    std::pmr::memory_resource* const m_upstream;
+};
+
+}  // namespace my::memory
@@ -0,0 +1,266 @@
+#include "profiler.h"
+
+#if USING(USE_NATIVE_PROFILER)
+#include "engine/core/io/file_access.h"
+#include "engine/core/io/print.h"
+
+namespace my::profiler {
+
+// events per thread and capture, events past that are dropped
+static constexpr uint32_t EVENT_CAPACITY = 1 << 16;
+static constexpr char FRAME_EVENT_NAME[] = "Frame";
+
+struct Event {
+    const char* name;
+    uint64_t begin;
+    uint64_t end;
+};
+
+// Only the owning thread writes events. The count is published with release semantics, so whoever
+// reads the buffer after loading the count sees complete events, without any locking.
+struct ThreadBuffer {
+    std::string name;
+    uint32_t index{ 0 };
+    std::atomic_uint32_t captureId{ 0 };
+    std::atomic_uint32_t count{ 0 };
+    std::atomic_uint32_t dropped{ 0 };
+    std::unique_ptr<Event[]> events;
+};
+
+std::atomic_uint32_t g_captureId{ 0 };
+
+static thread_local ThreadBuffer* s_threadBuffer = nullptr;
+
+static struct {
+    // guards everything but the content of the thread buffers
+    std::mutex lock;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    uint32_t nextCaptureId{ 1 };
+    uint32_t lastCaptureId{ 0 };
+    uint64_t captureBegin{ 0 };
+
+    // capture window requested with RequestCapture()
+    bool captureRequested{ false };
+    uint32_t framesUntilStart{ 0 };
+    uint32_t framesLeft{ 0 };
+    std::string capturePath;
+
+    // only touched by the thread calling MarkFrame()
+    uint64_t frameBegin{ 0 };
+} s_profilerGlob;
+
+uint64_t GetTimestamp() {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+static ThreadBuffer* GetThreadBuffer() {
+    if (!s_threadBuffer) {
+        std::lock_guard lock(s_profilerGlob.lock);
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->index = static_cast<uint32_t>(s_profilerGlob.buffers.size());
+        buffer->name = std::format("thread {}", buffer->index);
+        s_threadBuffer = buffer.get();
+        s_profilerGlob.buffers.emplace_back(std::move(buffer));
+    }
+    return s_threadBuffer;
+}
+
+void RecordEvent(uint32_t p_capture_id, const char* p_name, uint64_t p_begin, uint64_t p_end) {
+    ThreadBuffer* buffer = GetThreadBuffer();
+
+    const uint32_t buffer_capture_id = buffer->captureId.load(std::memory_order_relaxed);
+    if (buffer_capture_id != p_capture_id) {
+        // a scope that started in an earlier capture, and ended in a later one
+        if (buffer_capture_id > p_capture_id) {
+            return;
+        }
+
+        // first event of the thread in this capture
+        if (!buffer->events) {
+            buffer->events = std::make_unique<Event[]>(EVENT_CAPACITY);
+        }
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->dropped.store(0, std::memory_order_relaxed);
+        buffer->captureId.store(p_capture_id, std::memory_order_release);
+    }
+
+    const uint32_t count = buffer->count.load(std::memory_order_relaxed);
+    if (count >= EVENT_CAPACITY) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer->events[count] = Event{ p_name, p_begin, p_end };
+    buffer->count.store(count + 1, std::memory_order_release);
+}
+
+void RegisterThread(const char* p_name) {
+    ThreadBuffer* buffer = GetThreadBuffer();
+
+    std::lock_guard lock(s_profilerGlob.lock);
+    buffer->name = p_name;
+}
+
+static void BeginCaptureInternal() {
+    s_profilerGlob.lastCaptureId = s_profilerGlob.nextCaptureId++;
+    s_profilerGlob.captureBegin = GetTimestamp();
+    g_captureId.store(s_profilerGlob.lastCaptureId, std::memory_order_release);
+}
+
+static void EndCaptureInternal() {
+    g_captureId.store(0, std::memory_order_release);
+}
+
+void BeginCapture() {
+    std::lock_guard lock(s_profilerGlob.lock);
+    s_profilerGlob.captureRequested = false;
+    BeginCaptureInternal();
+}
+
+void EndCapture() {
+    std::lock_guard lock(s_profilerGlob.lock);
+    s_profilerGlob.captureRequested = false;
+    EndCaptureInternal();
+}
+
+bool IsCapturing() {
+    return g_captureId.load(std::memory_order_relaxed) != 0;
+}
+
+void RequestCapture(uint32_t p_start_frame, uint32_t p_frame_count, std::string_view p_path) {
+    ERR_FAIL_COND_MSG(p_frame_count == 0, "capture needs at least one frame");
+
+    std::lock_guard lock(s_profilerGlob.lock);
+    s_profilerGlob.captureRequested = true;
+    s_profilerGlob.framesUntilStart = p_start_frame;
+    s_profilerGlob.framesLeft = p_frame_count;
+    s_profilerGlob.capturePath = p_path;
+}
+
+void MarkFrame() {
+    const uint64_t now = GetTimestamp();
+
+    // the frame shows up as an event on the thread running the frames
+    const uint32_t capture_id = g_captureId.load(std::memory_order_relaxed);
+    if (capture_id && s_profilerGlob.frameBegin) {
+        RecordEvent(capture_id, FRAME_EVENT_NAME, s_profilerGlob.frameBegin, now);
+    }
+    s_profilerGlob.frameBegin = now;
+
+    std::string path;
+    {
+        std::lock_guard lock(s_profilerGlob.lock);
+        if (!s_profilerGlob.captureRequested) {
+            return;
+        }
+
+        if (!IsCapturing()) {
+            if (s_profilerGlob.framesUntilStart == 0) {
+                BeginCaptureInternal();
+            } else {
+                --s_profilerGlob.framesUntilStart;
+            }
+        } else if (--s_profilerGlob.framesLeft == 0) {
+            EndCaptureInternal();
+            s_profilerGlob.captureRequested = false;
+            path = std::move(s_profilerGlob.capturePath);
+        }
+    }
+
+    if (!path.empty()) {
+        if (auto res = WriteChromeTrace(path); !res) {
+            LOG_ERROR("failed to write capture to '{}'", path);
+            return;
+        }
+        LOG("capture written to '{}'", path);
+    }
+}
+
+static void AppendEscaped(std::string& p_out, std::string_view p_string) {
+    for (const char c : p_string) {
+        switch (c) {
+            case '"':
+                p_out += "\\\"";
+                break;
+            case '\\':
+                p_out += "\\\\";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    p_out += std::format("\\u{:04x}", static_cast<int>(c));
+                } else {
+                    p_out += c;
+                }
+                break;
+        }
+    }
+}
+
+// https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+auto WriteChromeTrace(std::string_view p_path) -> Result<void> {
+    std::string json;
+    uint32_t dropped = 0;
+    {
+        std::lock_guard lock(s_profilerGlob.lock);
+        if (IsCapturing()) {
+            return HBN_ERROR(ErrorCode::ERR_BUSY, "capture still in progress");
+        }
+        if (s_profilerGlob.lastCaptureId == 0) {
+            return HBN_ERROR(ErrorCode::ERR_DOES_NOT_EXIST, "nothing captured");
+        }
+
+        const uint32_t capture_id = s_profilerGlob.lastCaptureId;
+        const uint64_t capture_begin = s_profilerGlob.captureBegin;
+
+        json += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        for (const auto& buffer : s_profilerGlob.buffers) {
+            if (buffer->captureId.load(std::memory_order_acquire) != capture_id) {
+                continue;
+            }
+
+            json += first ? "\n" : ",\n";
+            first = false;
+            json += std::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{},\"args\":{{\"name\":\"", buffer->index);
+            AppendEscaped(json, buffer->name);
+            json += "\"}}";
+
+            const uint32_t count = buffer->count.load(std::memory_order_acquire);
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+            for (uint32_t i = 0; i < count; ++i) {
+                const Event& event = buffer->events[i];
+                // events that started before the capture are clamped to its beginning
+                const uint64_t begin = std::max(event.begin, capture_begin);
+                const uint64_t end = std::max(event.end, begin);
+
+                json += ",\n{\"name\":\"";
+                AppendEscaped(json, event.name);
+                json += std::format("\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                                    buffer->index,
+                                    (begin - capture_begin) * 1e-3,
+                                    (end - begin) * 1e-3);
+            }
+        }
+        json += "\n]}\n";
+    }
+
+    if (dropped) {
+        LOG_WARN("{} events dropped, a thread recorded more than {} events", dropped, EVENT_CAPACITY);
+    }
+
+    auto res = FileAccess::Open(p_path, FileAccess::WRITE);
+    if (!res) {
+        return HBN_ERROR(res.error());
+    }
+
+    auto file = *res;
+    if (file->WriteBuffer(json.data(), json.length()) != json.length()) {
+        return HBN_ERROR(ErrorCode::ERR_FILE_CANT_WRITE, "failed to write '{}'", p_path);
+    }
+    return Result<void>();
+}
+
+}  // namespace my::profiler
+#endif
@@ -1,15 +1,85 @@
 #pragma once
 
 // #define USE_PROFILER NOT_IN_USE
-#define USE_PROFILER USE_IF(USING(PLATFORM_WINDOWS))
+#define USE_PROFILER IN_USE
+// Optick is only available on Windows, the other platforms use the built-in profiler, which records
+// into per thread buffers and writes chrome trace files (chrome://tracing, ui.perfetto.dev)
+#define USE_OPTICK          USE_IF(USING(USE_PROFILER) && USING(PLATFORM_WINDOWS))
+#define USE_NATIVE_PROFILER USE_IF(USING(USE_PROFILER) && !USING(PLATFORM_WINDOWS))
 
-#if USING(USE_PROFILER)
+#if USING(USE_OPTICK)
 #include "optick/optick.h"
 #define HBN_PROFILE_FRAME(...)  OPTICK_FRAME(__VA_ARGS__)
 #define HBN_PROFILE_EVENT(...)  OPTICK_EVENT(__VA_ARGS__)
 #define HBN_PROFILE_THREAD(...) OPTICK_THREAD(__VA_ARGS__)
+#elif USING(USE_NATIVE_PROFILER)
+#define HBN_PROFILE_CONCAT_INTERNAL(a, b) a##b
+#define HBN_PROFILE_CONCAT(a, b)          HBN_PROFILE_CONCAT_INTERNAL(a, b)
+#define HBN_PROFILE_FRAME(...)            ::my::profiler::MarkFrame()
+#define HBN_PROFILE_EVENT(...)            const ::my::profiler::ScopedEvent HBN_PROFILE_CONCAT(_profile_event_, __LINE__)(__FUNCTION__ __VA_OPT__(, ) __VA_ARGS__)
+#define HBN_PROFILE_THREAD(...)           ::my::profiler::RegisterThread(__VA_ARGS__)
 #else
 #define HBN_PROFILE_FRAME(...)  (void)0
 #define HBN_PROFILE_EVENT(...)  (void)0
 #define HBN_PROFILE_THREAD(...) (void)0
 #endif
+
+#if USING(USE_NATIVE_PROFILER)
+namespace my::profiler {
+
+// Event names are not copied, they have to outlive the capture. The macros only pass string literals
+// and __FUNCTION__.
+
+// id of the capture in progress, 0 if nothing is being recorded
+extern std::atomic_uint32_t g_captureId;
+
+uint64_t GetTimestamp();
+
+void RecordEvent(uint32_t p_capture_id, const char* p_name, uint64_t p_begin, uint64_t p_end);
+
+class ScopedEvent {
+public:
+    explicit ScopedEvent(const char* p_function) : ScopedEvent(p_function, p_function) {}
+
+    ScopedEvent(const char*, const char* p_name) : m_name(p_name),
+                                                   m_captureId(g_captureId.load(std::memory_order_relaxed)) {
+        if (m_captureId) {
+            m_begin = GetTimestamp();
+        }
+    }
+
+    ~ScopedEvent() {
+        if (m_captureId) {
+            RecordEvent(m_captureId, m_name, m_begin, GetTimestamp());
+        }
+    }
+
+    ScopedEvent(const ScopedEvent&) = delete;
+    ScopedEvent& operator=(const ScopedEvent&) = delete;
+
+private:
+    const char* m_name;
+    uint32_t m_captureId;
+    uint64_t m_begin{ 0 };
+};
+
+// names the calling thread in captures, threads that record without registering are named by index
+void RegisterThread(const char* p_name);
+
+// Marks the end of a frame. Captures requested with RequestCapture() start and stop on frame boundaries.
+void MarkFrame();
+
+// Records p_frame_count frames, starting p_start_frame frames from now, then writes the capture to p_path
+void RequestCapture(uint32_t p_start_frame, uint32_t p_frame_count, std::string_view p_path);
+
+// Manual control, for code that doesn't run frames, e.g. tests and tools. BeginCapture() throws away
+// the previous capture.
+void BeginCapture();
+void EndCapture();
+bool IsCapturing();
+
+// writes the last capture in chrome trace event format
+[[nodiscard]] auto WriteChromeTrace(std::string_view p_path) -> Result<void>;
+
+}  // namespace my::profiler
+#endif
@@ -261,7 +261,7 @@ void DynamicVariable::PrintValueChange(std::string_view p_source) const {
     LOG_VERBOSE("[dvar] change dvar '{}'({}) to {} (source: {})", m_name, s_names[m_type], value_string, p_source);
 }
 
-DynamicVariable* DynamicVariable::FindDvar(const std::string& p_name) {
+DynamicVariable* DynamicVariable::FindDvar(StringId p_name) {
     auto it = s_map.find(p_name);
     if (it == s_map.end()) {
         return nullptr;
@@ -270,15 +270,15 @@ DynamicVariable* DynamicVariable::FindDvar(const std::string& p_name) {
 }
 
 void DynamicVariable::RegisterDvar(std::string_view p_key, DynamicVariable* p_dvar) {
-    const std::string keyStr(p_key);
-    auto it = s_map.find(keyStr);
+    const StringId key = StringId::Intern(p_key);
+    auto it = s_map.find(key);
     if (it != s_map.end()) {
         LOG_ERROR("duplicated dvar {} detected", p_key);
     }
 
     p_dvar->m_name = p_key;
 
-    s_map.insert(std::make_pair(keyStr, p_dvar));
+    s_map.insert(std::make_pair(key, p_dvar));
 }
 
 }  // namespace my
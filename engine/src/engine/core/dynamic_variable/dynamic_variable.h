@@ -1,4 +1,5 @@
 #pragma once
+#include "engine/core/string/string_id.h"
 #include "engine/math/vector.h"
 
 enum DvarFlags : uint32_t {
@@ -70,7 +71,8 @@ public:
     const char* GetDesc() const { return m_desc; }
     uint32_t GetFlags() const { return m_flags; }
 
-    static DynamicVariable* FindDvar(const std::string& p_name);
+    static DynamicVariable* FindDvar(std::string_view p_name) { return FindDvar(StringId(p_name)); }
+    static DynamicVariable* FindDvar(StringId p_name);
     static void RegisterDvar(std::string_view p_key, DynamicVariable* p_dvar);
 
 private:
@@ -87,7 +89,7 @@ private:
     std::string m_string;
     std::string m_name;
 
-    inline static std::unordered_map<std::string, DynamicVariable*> s_map;
+    inline static std::unordered_map<StringId, DynamicVariable*> s_map;
     friend class DynamicVariableManager;
 };
 
@@ -62,7 +62,7 @@ void DynamicVariableManager::Deserialize(std::string_view p_path) {
 
 void DynamicVariableManager::DumpDvars() {
     for (const auto& it : DynamicVariable::s_map) {
-        PRINT("-- {}, '{}'", it.first, it.second->GetDesc());
+        PRINT("-- {}, '{}'", it.second->m_name, it.second->GetDesc());
     }
 }
 
@@ -2,12 +2,14 @@
 
 #include <imgui/imgui.h>
 
+#include "engine/core/debugger/memory_tracker.h"
 #include "engine/core/debugger/profiler.h"
 #include "engine/core/dynamic_variable/dynamic_variable_manager.h"
 #include "engine/core/framework/asset_manager.h"
 #include "engine/core/framework/asset_registry.h"
 #include "engine/core/framework/common_dvars.h"
 #include "engine/core/framework/display_manager.h"
+#include "engine/core/framework/engine.h"
 #include "engine/core/framework/graphics_manager.h"
 #include "engine/core/framework/imgui_manager.h"
 #include "engine/core/framework/input_manager.h"
@@ -163,6 +165,13 @@ auto Application::Initialize(int p_argc, const char** p_argv) -> Result<void> {
     // parse happens after deserialization, so command line will override cache
     DynamicVariableManager::Parse(m_commandLine);
 
+    {
+        thread::ThreadConfig config;
+        config.jobWorkerCount = DVAR_GET_INT(thread_job_workers);
+        config.pinJobWorkers = DVAR_GET_BOOL(thread_affinity);
+        engine::InitializeThreads(config);
+    }
+
     // select window size
     {
         const Vector2i resolution{ DVAR_GET_IVEC2(window_resolution) };
@@ -179,6 +188,15 @@ auto Application::Initialize(int p_argc, const char** p_argv) -> Result<void> {
         m_specification.height = desired_size.y;
     }
 
+#if USING(USE_NATIVE_PROFILER)
+    if (const int frame_count = DVAR_GET_INT(profiler_capture_frames); frame_count > 0) {
+        const int start_frame = DVAR_GET_INT(profiler_capture_start);
+        profiler::RequestCapture(static_cast<uint32_t>(std::max(start_frame, 0)),
+                                 static_cast<uint32_t>(frame_count),
+                                 DVAR_GET_STRING(profiler_capture_path));
+    }
+#endif
+
     // select backend
     {
         const std::string& backend = DVAR_GET_STRING(gfx_backend);
@@ -257,6 +275,7 @@ void Application::Run() {
     Timer timer;
     do {
         HBN_PROFILE_FRAME("MainThread");
+        memory::UpdateStats();
 
         m_displayServer->BeginFrame();
         if (m_displayServer->ShouldClose()) {
@@ -4,6 +4,7 @@
 
 #include "engine/assets/asset_loader.h"
 #include "engine/assets/gltf_loader.h"
+#include "engine/core/base/backoff.h"
 #include "engine/core/framework/application.h"
 #include "engine/core/framework/asset_registry.h"
 #include "engine/core/framework/graphics_manager.h"
@@ -12,6 +13,7 @@
 #include "engine/core/os/timer.h"
 #include "engine/core/string/string_builder.h"
 #include "engine/scene/scene.h"
+#include "engine/systems/job_system/job_system.h"
 
 // plugins
 #include "plugins/loader_assimp/assimp_asset_loader.h"
@@ -30,12 +32,10 @@ struct LoadTask {
 };
 
 static struct {
-    // @TODO: better wake up
-    std::condition_variable wakeCondition;
-    std::mutex wakeMutex;
-    // @TODO: better thread safe queue
-    ConcurrentQueue<LoadTask> jobQueue;
-    std::atomic_int runningWorkers;
+    // load tasks queued or running
+    std::atomic_int pendingTasks;
+    // set on finalize, the loads that haven't started yet are dropped
+    std::atomic_bool cancelled;
 } s_assetManagerGlob;
 
 auto AssetManager::InitializeImpl() -> Result<void> {
@@ -117,31 +117,32 @@ void AssetManager::LoadAssetAsync(AssetRegistryHandle* p_handle, OnAssetLoadSucc
 }
 
 void AssetManager::FinalizeImpl() {
-    RequestShutdown();
+    s_assetManagerGlob.cancelled.store(true);
+    // Loads still running write into m_assets, and the queued ones only free their job once they ran. The
+    // workers stopped at the shutdown request, so the queued ones are run (and dropped) here.
+    jobsystem::RunJobsUntil(jobsystem::JOB_PRIORITY_BACKGROUND, []() {
+        return s_assetManagerGlob.pendingTasks.load() == 0;
+    });
 
     m_assets.clear();
 }
 
-void AssetManager::EnqueueLoadTask(LoadTask& p_task) {
-    s_assetManagerGlob.jobQueue.push(std::move(p_task));
-    s_assetManagerGlob.wakeCondition.notify_one();
+static void FinishLoadTask() {
+    if (s_assetManagerGlob.pendingTasks.fetch_sub(1) == 1) {
+        s_assetManagerGlob.pendingTasks.notify_all();
+    }
 }
 
-void AssetManager::WorkerMain() {
-    for (;;) {
-        if (thread::ShutdownRequested()) {
-            break;
-        }
+void AssetManager::EnqueueLoadTask(LoadTask& p_task) {
+    s_assetManagerGlob.pendingTasks.fetch_add(1);
 
-        LoadTask task;
-        if (!s_assetManagerGlob.jobQueue.pop(task)) {
-            std::unique_lock<std::mutex> lock(s_assetManagerGlob.wakeMutex);
-            s_assetManagerGlob.wakeCondition.wait(lock);
-            continue;
+    // decoding can take several frames, it runs on the background lane so it never delays frame jobs
+    jobsystem::RunAsync(jobsystem::JOB_PRIORITY_BACKGROUND, [task = std::move(p_task)]() {
+        if (s_assetManagerGlob.cancelled.load()) {
+            FinishLoadTask();
+            return;
         }
 
-        s_assetManagerGlob.runningWorkers.fetch_add(1);
-
         Timer timer;
         auto res = AssetManager::GetSingleton().LoadAssetSync(task.handle);
 
@@ -157,18 +158,13 @@ void AssetManager::WorkerMain() {
             LOG_ERROR("{}", builder.ToString());
         }
 
-        s_assetManagerGlob.runningWorkers.fetch_sub(1);
-    }
+        FinishLoadTask();
+    });
 }
 
 void AssetManager::Wait() {
-    while (s_assetManagerGlob.runningWorkers.load() != 0) {
-        // dummy for loop
-    }
-}
-
-void AssetManager::RequestShutdown() {
-    s_assetManagerGlob.wakeCondition.notify_all();
+    // loading takes a while, the thread ends up parked instead of burning a core
+    WaitUntil(s_assetManagerGlob.pendingTasks, [](int p_pending) { return p_pending == 0; });
 }
 
 }  // namespace my
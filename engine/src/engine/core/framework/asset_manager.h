@@ -21,9 +21,7 @@ public:
 
     auto LoadFileSync(const FilePath& p_path) -> Result<std::shared_ptr<IAsset>>;
 
-    static void WorkerMain();
     static void Wait();
-    static void RequestShutdown();
 
 private:
     [[nodiscard]] auto LoadAssetSync(AssetRegistryHandle* p_handle) -> Result<IAsset*>;
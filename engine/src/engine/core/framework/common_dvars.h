@@ -9,7 +9,16 @@ DVAR_STRING(project, DVAR_FLAG_NONE, "Open project at start", "");
 // IO
 DVAR_BOOL(verbose, DVAR_FLAG_NONE, "Print verbose log", true);
 
+// threads
+DVAR_INT(thread_job_workers, DVAR_FLAG_NONE, "Number of job system workers, 0 to size from the cpu topology", 0);
+DVAR_BOOL(thread_affinity, DVAR_FLAG_NONE, "Pin job workers to physical cores", true);
+
 // gui
 DVAR_BOOL(show_editor, DVAR_FLAG_CACHE, "Show editor", true);
 
+// profiler
+DVAR_INT(profiler_capture_start, DVAR_FLAG_NONE, "Frame to start the profiler capture at", 0);
+DVAR_INT(profiler_capture_frames, DVAR_FLAG_NONE, "Number of frames to capture, 0 to disable", 0);
+DVAR_STRING(profiler_capture_path, DVAR_FLAG_NONE, "Chrome trace file the capture is written to", "@user://capture.json");
+
 #include "engine/core/dynamic_variable/dynamic_variable_end.h"
@@ -1,5 +1,6 @@
 #include "engine.h"
 
+#include "engine/core/os/cpu_topology.h"
 #include "engine/core/os/os.h"
 #include "engine/core/os/threads.h"
 #include "engine/systems/job_system/job_system.h"
@@ -15,10 +16,23 @@ bool engine::InitializeCore() {
 
     s_os = new OS;
     s_os->Initialize();
+    return true;
+}
+
+bool engine::InitializeThreads(const thread::ThreadConfig& p_config) {
+    const CpuTopology topology = DetectCpuTopology();
+    const thread::ThreadLayout layout = thread::ComputeThreadLayout(topology, p_config);
 
-    thread::Initialize();
-    jobsystem::Initialize();
+    LOG("[threads] {} cores ({} logical, {} numa nodes, {} cache clusters), {} job workers",
+        topology.cores.size(),
+        topology.logicalCount,
+        topology.numaNodeCount,
+        topology.cacheClusterCount,
+        layout.jobWorkerCount);
 
+    // the workers touch their queues as soon as they start
+    jobsystem::Initialize(layout.jobWorkerCount);
+    thread::Initialize(layout);
     return true;
 }
 
@@ -1,8 +1,12 @@
 #pragma once
+#include "engine/core/os/threads.h"
 
 namespace my::engine {
 
 bool InitializeCore();
+// Starts the job workers, sized from the cpu topology unless p_config overrides it.
+// Application calls it once the dvars are parsed.
+bool InitializeThreads(const thread::ThreadConfig& p_config = {});
 void FinalizeCore();
 
 }  // namespace my::engine
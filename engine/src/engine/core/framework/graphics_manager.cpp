@@ -137,7 +137,8 @@ auto GraphicsManager::InitializeImpl() -> Result<void> {
     m_skyboxBuffers = *CreateMesh(MakeSkyBoxMesh());
     m_boxBuffers = *CreateMesh(MakeBoxMesh());
 
-    m_brdfImage = m_app->GetAssetRegistry()->GetAssetByHandle<ImageAsset>(AssetHandle{ "@res://images/brdf.hdr" });
+    static constexpr StringId s_brdf_path("@res://images/brdf.hdr");
+    m_brdfImage = m_app->GetAssetRegistry()->GetAssetByHandle<ImageAsset>(AssetHandle{ s_brdf_path });
 
     // @TODO: refactor
     {
@@ -119,8 +119,8 @@ public:
     virtual void UnbindStructuredBufferSRV(int p_slot) = 0;
 
     virtual void UpdateConstantBuffer(const GpuConstantBuffer* p_buffer, const void* p_data, size_t p_size) = 0;
-    template<typename T>
-    void UpdateConstantBuffer(const GpuConstantBuffer* p_buffer, const std::vector<T>& p_vector) {
+    template<typename T, typename ALLOCATOR>
+    void UpdateConstantBuffer(const GpuConstantBuffer* p_buffer, const std::vector<T, ALLOCATOR>& p_vector) {
         UpdateConstantBuffer(p_buffer, p_vector.data(), sizeof(T) * (uint32_t)p_vector.size());
     }
     template<typename T, int N>
@@ -1,5 +1,6 @@
 #include "archive.h"
 
+#include "engine/core/io/file_access_mmap.h"
 #include "engine/core/io/print.h"
 
 namespace my {
@@ -20,12 +21,45 @@ auto Archive::OpenMode(const std::string& p_path, bool p_write_mode) -> Result<v
     return Result<void>();
 }
 
+auto Archive::OpenReadMapped(const std::string& p_path) -> Result<void> {
+    m_path = p_path;
+    m_isWriteMode = false;
+
+    auto result = FileAccessMmap::Open(m_path);
+    if (!result) {
+        return HBN_ERROR(result.error());
+    }
+
+    m_mapped = result->get();
+    m_file = *result;
+    return Result<void>();
+}
+
+auto Archive::OpenReadMapped(const Archive& p_source, size_t p_offset, size_t p_size) -> Result<void> {
+    if (!p_source.m_mapped) {
+        return HBN_ERROR(ErrorCode::ERR_INVALID_PARAMETER, "archive '{}' is not mapped", p_source.m_path);
+    }
+
+    m_path = p_source.m_path;
+    m_isWriteMode = false;
+
+    auto result = FileAccessMmap::OpenView(std::static_pointer_cast<FileAccessMmap>(p_source.m_file), p_offset, p_size);
+    if (!result) {
+        return HBN_ERROR(result.error());
+    }
+
+    m_mapped = result->get();
+    m_file = *result;
+    return Result<void>();
+}
+
 void Archive::Close() {
     if (!m_file) {
         return;
     }
 
     m_file.reset();
+    m_mapped = nullptr;
 
     if (m_isWriteMode) {
         namespace fs = std::filesystem;
@@ -56,9 +90,29 @@ bool Archive::Write(const void* p_data, size_t p_size) {
 
 bool Archive::Read(void* p_data, size_t p_size) {
     DEV_ASSERT(m_file && !m_isWriteMode);
+    if (m_mapped) {
+        const uint8_t* data = m_mapped->Consume(p_size);
+        if (!data) {
+            return false;
+        }
+        memcpy(p_data, data, p_size);
+        return true;
+    }
+
     return m_file->ReadBuffer(p_data, p_size) == p_size;
 }
 
+std::span<const uint8_t> Archive::ReadBytes(size_t p_size) {
+    DEV_ASSERT(m_file && !m_isWriteMode);
+    ERR_FAIL_COND_V_MSG(!m_mapped, {}, "archive is not mapped");
+
+    const uint8_t* data = m_mapped->Consume(p_size);
+    if (!data) {
+        return {};
+    }
+    return std::span<const uint8_t>(data, p_size);
+}
+
 bool Archive::WriteString(const char* p_data, size_t p_length) {
     bool ok = true;
     ok = ok && Write(p_length);
@@ -3,6 +3,8 @@
 
 namespace my {
 
+class FileAccessMmap;
+
 class Archive {
 public:
     ~Archive() {
@@ -11,6 +13,10 @@ public:
 
     [[nodiscard]] auto OpenRead(const std::string& p_path) -> Result<void> { return OpenMode(p_path.c_str(), false); }
     [[nodiscard]] auto OpenWrite(const std::string& p_path) -> Result<void> { return OpenMode(p_path.c_str(), true); }
+    // maps the whole file, reads are copies out of the mapping and ReadBytes()/ReadSpan() reference it directly
+    [[nodiscard]] auto OpenReadMapped(const std::string& p_path) -> Result<void>;
+    // reads [p_offset, p_offset + p_size) of a mapped archive with a cursor of its own, the mapping is shared
+    [[nodiscard]] auto OpenReadMapped(const Archive& p_source, size_t p_offset, size_t p_size) -> Result<void>;
 
     void Close();
     bool IsWriteMode() const;
@@ -27,8 +33,7 @@ public:
 
     template<typename T>
     bool Read(T& p_value) {
-        const size_t read = m_file->Read(p_value);
-        return read == sizeof(T);
+        return Read(&p_value, sizeof(T));
     }
 
     template<>
@@ -66,6 +71,36 @@ public:
         return Read(p_value.data(), sizeof(T) * size);
     }
 
+    bool IsMapped() const { return m_mapped != nullptr; }
+
+    // Only works on a mapped archive. Returns the next p_size bytes without copying them, the span stays
+    // valid until the archive is closed. Returns an empty span if there isn't enough data left.
+    std::span<const uint8_t> ReadBytes(size_t p_size);
+
+    // Reads a vector written by Write(const std::vector<T>&) as a span into the mapping. Fails without
+    // consuming anything if the archive isn't mapped or the data isn't aligned for T, Read(std::vector<T>&)
+    // works in every case.
+    template<typename T>
+        requires TriviallyCopyable<T>
+    bool ReadSpan(std::span<const T>& p_value) {
+        if (!m_mapped) {
+            return false;
+        }
+
+        const long position = m_file->Tell();
+        uint64_t size = 0;
+        if (Read(size)) {
+            std::span<const uint8_t> bytes = ReadBytes(sizeof(T) * size);
+            if (bytes.size() == sizeof(T) * size && reinterpret_cast<uintptr_t>(bytes.data()) % alignof(T) == 0) {
+                p_value = std::span<const T>(reinterpret_cast<const T*>(bytes.data()), size);
+                return true;
+            }
+        }
+
+        m_file->Seek(position);
+        return false;
+    }
+
     template<typename T, class = typename std::enable_if<std::is_trivially_copyable<T>::value>::type>
     Archive& operator>>(std::vector<T>& p_value) {
         uint64_t size = 0;
@@ -105,6 +140,8 @@ private:
 
     bool m_isWriteMode{ false };
     std::shared_ptr<FileAccess> m_file{};
+    // same object as m_file when the archive is mapped
+    FileAccessMmap* m_mapped{ nullptr };
     std::string m_path{};
 };
 
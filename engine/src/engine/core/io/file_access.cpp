@@ -17,15 +17,19 @@ auto FileAccess::Create(AccessType p_access_type) -> std::shared_ptr<FileAccess>
 }
 
 auto FileAccess::CreateForPath(std::string_view p_path) -> std::shared_ptr<FileAccess> {
+    return Create(GetAccessTypeForPath(p_path));
+}
+
+auto FileAccess::GetAccessTypeForPath(std::string_view p_path) -> AccessType {
     if (p_path.starts_with("@res://")) {
-        return Create(ACCESS_RESOURCE);
+        return ACCESS_RESOURCE;
     }
 
     if (p_path.starts_with("@user://")) {
-        return Create(ACCESS_USERDATA);
+        return ACCESS_USERDATA;
     }
 
-    return Create(ACCESS_FILESYSTEM);
+    return ACCESS_FILESYSTEM;
 }
 
 auto FileAccess::Open(std::string_view p_path, ModeFlags p_mode_flags) -> Result<std::shared_ptr<FileAccess>> {
@@ -68,6 +68,7 @@ public:
 
     static auto Create(AccessType p_access_type) -> std::shared_ptr<FileAccess>;
     static auto CreateForPath(std::string_view p_path) -> std::shared_ptr<FileAccess>;
+    static auto GetAccessTypeForPath(std::string_view p_path) -> AccessType;
 
     static auto Open(std::string_view p_path, ModeFlags p_mode_flags) -> Result<std::shared_ptr<FileAccess>>;
     static auto Open(const FilePath& p_path, ModeFlags p_mode_flags) -> Result<std::shared_ptr<FileAccess>> {
@@ -0,0 +1,213 @@
+#include "file_access_mmap.h"
+
+#include "engine/drivers/windows/win32_prerequisites.h"
+
+#if !USING(PLATFORM_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace my {
+
+FileAccessMmap::~FileAccessMmap() { Close(); }
+
+auto FileAccessMmap::Open(std::string_view p_path) -> Result<std::shared_ptr<FileAccessMmap>> {
+    auto file_access = std::make_shared<FileAccessMmap>();
+    file_access->SetAccessType(GetAccessTypeForPath(p_path));
+
+    if (auto res = file_access->OpenInternal(file_access->FixPath(p_path), READ); !res) {
+        return HBN_ERROR(res.error());
+    }
+
+    return file_access;
+}
+
+auto FileAccessMmap::OpenView(const std::shared_ptr<FileAccessMmap>& p_source,
+                              size_t p_offset,
+                              size_t p_size) -> Result<std::shared_ptr<FileAccessMmap>> {
+    DEV_ASSERT(p_source);
+    if (!p_source->IsOpen()) {
+        return HBN_ERROR(ErrorCode::ERR_FILE_CANT_READ, "source file is not open");
+    }
+    if (p_offset > p_source->m_length || p_size > p_source->m_length - p_offset) {
+        return HBN_ERROR(ErrorCode::ERR_INVALID_PARAMETER, "view [{}, {}) is out of range, file length is {}", p_offset, p_offset + p_size, p_source->m_length);
+    }
+
+    auto view = std::make_shared<FileAccessMmap>();
+    view->m_accessType = p_source->m_accessType;
+    view->m_openMode = READ;
+    // views of views reference the owner of the mapping directly
+    view->m_source = p_source->m_source ? p_source->m_source : p_source;
+    view->m_data = p_source->m_data ? p_source->m_data + p_offset : nullptr;
+    view->m_length = p_size;
+    return view;
+}
+
+void FileAccessMmap::Close() {
+    if (m_source) {
+        m_source.reset();
+    } else {
+        CloseMapping();
+    }
+
+    m_data = nullptr;
+    m_length = 0;
+    m_cursor = 0;
+}
+
+#if USING(PLATFORM_WINDOWS)
+auto FileAccessMmap::OpenInternal(std::string_view p_path, ModeFlags p_mode_flags) -> Result<void> {
+    ERR_FAIL_COND_V(m_fileHandle, HBN_ERROR(ErrorCode::ERR_FILE_ALREADY_IN_USE, "file '{}' already in use", p_path));
+    if (p_mode_flags != READ) {
+        return HBN_ERROR(ErrorCode::ERR_INVALID_PARAMETER, "file '{}' can only be mapped for reading", p_path);
+    }
+
+    std::string path_string{ p_path };
+    HANDLE file = CreateFileA(path_string.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        switch (GetLastError()) {
+            case ERROR_FILE_NOT_FOUND:
+            case ERROR_PATH_NOT_FOUND:
+                return HBN_ERROR(ErrorCode::ERR_FILE_NOT_FOUND, "file '{}' not found", p_path);
+            default:
+                return HBN_ERROR(ErrorCode::ERR_FILE_CANT_OPEN, "failed to open file '{}'", p_path);
+        }
+    }
+
+    m_fileHandle = file;
+    m_openMode = p_mode_flags;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        Close();
+        return HBN_ERROR(ErrorCode::ERR_FILE_CANT_READ, "failed to get size of file '{}'", p_path);
+    }
+
+    m_length = static_cast<size_t>(size.QuadPart);
+    // an empty file can't be mapped, but it's still a valid file
+    if (m_length == 0) {
+        return Result<void>();
+    }
+
+    m_mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mappingHandle) {
+        m_data = static_cast<const uint8_t*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (!m_data) {
+        Close();
+        return HBN_ERROR(ErrorCode::ERR_FILE_CANT_READ, "failed to map file '{}'", p_path);
+    }
+
+    return Result<void>();
+}
+
+void FileAccessMmap::CloseMapping() {
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mappingHandle) {
+        CloseHandle(m_mappingHandle);
+    }
+    if (m_fileHandle) {
+        CloseHandle(m_fileHandle);
+    }
+
+    m_mappingHandle = nullptr;
+    m_fileHandle = nullptr;
+}
+
+bool FileAccessMmap::IsOpen() const {
+    return m_source || m_fileHandle != nullptr;
+}
+#else
+auto FileAccessMmap::OpenInternal(std::string_view p_path, ModeFlags p_mode_flags) -> Result<void> {
+    ERR_FAIL_COND_V(m_fileHandle >= 0, HBN_ERROR(ErrorCode::ERR_FILE_ALREADY_IN_USE, "file '{}' already in use", p_path));
+    if (p_mode_flags != READ) {
+        return HBN_ERROR(ErrorCode::ERR_INVALID_PARAMETER, "file '{}' can only be mapped for reading", p_path);
+    }
+
+    std::string path_string{ p_path };
+    const int fd = open(path_string.c_str(), O_RDONLY);
+    if (fd < 0) {
+        switch (errno) {
+            case ENOENT:
+                return HBN_ERROR(ErrorCode::ERR_FILE_NOT_FOUND, "file '{}' not found", p_path);
+            default:
+                return HBN_ERROR(ErrorCode::ERR_FILE_CANT_OPEN, "failed to open file '{}'", p_path);
+        }
+    }
+
+    m_fileHandle = fd;
+    m_openMode = p_mode_flags;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        Close();
+        return HBN_ERROR(ErrorCode::ERR_FILE_CANT_READ, "'{}' is not a regular file", p_path);
+    }
+
+    m_length = static_cast<size_t>(info.st_size);
+    // an empty file can't be mapped, but it's still a valid file
+    if (m_length == 0) {
+        return Result<void>();
+    }
+
+    void* data = mmap(nullptr, m_length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        Close();
+        return HBN_ERROR(ErrorCode::ERR_FILE_CANT_READ, "failed to map file '{}'", p_path);
+    }
+
+    // the file is usually read front to back
+    madvise(data, m_length, MADV_SEQUENTIAL);
+    m_data = static_cast<const uint8_t*>(data);
+    return Result<void>();
+}
+
+void FileAccessMmap::CloseMapping() {
+    if (m_data) {
+        munmap(const_cast<uint8_t*>(m_data), m_length);
+    }
+    if (m_fileHandle >= 0) {
+        close(m_fileHandle);
+    }
+
+    m_fileHandle = -1;
+}
+
+bool FileAccessMmap::IsOpen() const {
+    return m_source || m_fileHandle >= 0;
+}
+#endif
+
+size_t FileAccessMmap::ReadBuffer(void* p_data, size_t p_size) const {
+    ERR_FAIL_COND_V(!IsOpen(), 0);
+
+    const size_t size = std::min(p_size, m_length - m_cursor);
+    if (size) {
+        memcpy(p_data, m_data + m_cursor, size);
+        m_cursor += size;
+    }
+    return size;
+}
+
+size_t FileAccessMmap::WriteBuffer(const void*, size_t) {
+    ERR_FAIL_V_MSG(0, "mapped files are read only");
+}
+
+int FileAccessMmap::Seek(long p_offset) {
+    ERR_FAIL_COND_V(!IsOpen(), -1);
+
+    // same as fseek(), 0 on success
+    if (p_offset < 0 || static_cast<size_t>(p_offset) > m_length) {
+        LOG_ERROR("seek failed");
+        return -1;
+    }
+
+    m_cursor = static_cast<size_t>(p_offset);
+    return 0;
+}
+
+}  // namespace my
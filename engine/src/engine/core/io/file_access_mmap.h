@@ -0,0 +1,60 @@
+#pragma once
+#include "file_access.h"
+
+namespace my {
+
+// Read only file access backed by a memory mapping of the whole file. Reads are plain copies out
+// of the mapping, and GetData() exposes the mapping itself so callers can reference the content
+// without copying. The mapping is valid until the file is closed.
+class FileAccessMmap : public FileAccess {
+public:
+    ~FileAccessMmap();
+
+    void Close() override;
+    bool IsOpen() const override;
+    size_t GetLength() const override { return m_length; }
+    size_t ReadBuffer(void* p_data, size_t p_size) const override;
+    size_t WriteBuffer(const void* p_data, size_t p_size) override;
+    long Tell() override { return static_cast<long>(m_cursor); }
+    int Seek(long p_offset) override;
+
+    const uint8_t* GetData() const { return m_data; }
+
+    // returns a pointer to the next p_size bytes and moves past them, nullptr if there aren't enough left
+    const uint8_t* Consume(size_t p_size) const {
+        if (p_size > m_length - m_cursor) {
+            return nullptr;
+        }
+        const uint8_t* data = m_data + m_cursor;
+        m_cursor += p_size;
+        return data;
+    }
+
+    static auto Open(std::string_view p_path) -> Result<std::shared_ptr<FileAccessMmap>>;
+
+    // A file access over [p_offset, p_offset + p_size) of an open mapping, with its own cursor. The view
+    // keeps the mapping alive, so several views can be read concurrently and outlive p_source.
+    static auto OpenView(const std::shared_ptr<FileAccessMmap>& p_source,
+                         size_t p_offset,
+                         size_t p_size) -> Result<std::shared_ptr<FileAccessMmap>>;
+
+protected:
+    auto OpenInternal(std::string_view p_path, ModeFlags p_mode_flags) -> Result<void> override;
+
+    void CloseMapping();
+
+    const uint8_t* m_data{ nullptr };
+    size_t m_length{ 0 };
+    mutable size_t m_cursor{ 0 };
+    // set for views, which don't own a mapping
+    std::shared_ptr<FileAccessMmap> m_source;
+
+#if USING(PLATFORM_WINDOWS)
+    void* m_fileHandle{ nullptr };
+    void* m_mappingHandle{ nullptr };
+#else
+    int m_fileHandle{ -1 };
+#endif
+};
+
+}  // namespace my
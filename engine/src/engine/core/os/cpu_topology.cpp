@@ -0,0 +1,191 @@
+#include "cpu_topology.h"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+
+namespace my {
+
+namespace fs = std::filesystem;
+
+std::vector<uint32_t> ParseCpuList(std::string_view p_list) {
+    auto is_space = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; };
+    auto parse = [](const char*& p_it, const char* p_end, uint32_t& p_out) {
+        auto [ptr, ec] = std::from_chars(p_it, p_end, p_out);
+        p_it = ptr;
+        return ec == std::errc();
+    };
+
+    while (!p_list.empty() && is_space(p_list.back())) {
+        p_list.remove_suffix(1);
+    }
+    while (!p_list.empty() && is_space(p_list.front())) {
+        p_list.remove_prefix(1);
+    }
+
+    std::vector<uint32_t> result;
+    const char* it = p_list.data();
+    const char* end = p_list.data() + p_list.size();
+    while (it < end) {
+        uint32_t first = 0;
+        if (!parse(it, end, first)) {
+            return {};
+        }
+
+        uint32_t last = first;
+        if (it < end && *it == '-') {
+            ++it;
+            if (!parse(it, end, last) || last < first) {
+                return {};
+            }
+        }
+
+        for (uint32_t cpu = first; cpu <= last; ++cpu) {
+            result.push_back(cpu);
+        }
+
+        if (it < end) {
+            if (*it != ',') {
+                return {};
+            }
+            ++it;
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+static std::string ReadLine(const fs::path& p_path) {
+    std::ifstream file(p_path);
+    std::string line;
+    if (file) {
+        std::getline(file, line);
+    }
+    return line;
+}
+
+static bool ReadUint(const fs::path& p_path, uint32_t& p_out) {
+    const std::string line = ReadLine(p_path);
+    auto [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), p_out);
+    return ec == std::errc() && ptr != line.data();
+}
+
+// logical processors sharing the highest cache level with p_cpu_dir
+static std::vector<uint32_t> ReadLastLevelCache(const fs::path& p_cpu_dir) {
+    std::error_code ec;
+    fs::directory_iterator it(p_cpu_dir / "cache", ec);
+    if (ec) {
+        return {};
+    }
+
+    uint32_t best_level = 0;
+    std::vector<uint32_t> best;
+    for (const auto& entry : it) {
+        if (!entry.path().filename().string().starts_with("index")) {
+            continue;
+        }
+
+        uint32_t level = 0;
+        if (!ReadUint(entry.path() / "level", level) || level <= best_level) {
+            continue;
+        }
+
+        std::vector<uint32_t> shared = ParseCpuList(ReadLine(entry.path() / "shared_cpu_list"));
+        if (!shared.empty()) {
+            best_level = level;
+            best = std::move(shared);
+        }
+    }
+    return best;
+}
+
+CpuTopology ReadSysfsTopology(const fs::path& p_root) {
+    CpuTopology topology;
+
+    const std::vector<uint32_t> online = ParseCpuList(ReadLine(p_root / "cpu" / "online"));
+    if (online.empty()) {
+        return topology;
+    }
+
+    std::unordered_map<uint32_t, uint32_t> numa_nodes;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(p_root / "node", ec)) {
+        const std::string name = entry.path().filename().string();
+        uint32_t node = 0;
+        if (!name.starts_with("node") ||
+            std::from_chars(name.data() + 4, name.data() + name.size(), node).ec != std::errc()) {
+            continue;
+        }
+        for (uint32_t cpu : ParseCpuList(ReadLine(entry.path() / "cpulist"))) {
+            numa_nodes[cpu] = node;
+        }
+    }
+
+    // cores are keyed by their first SMT sibling, clusters by the first cpu sharing the cache
+    std::map<uint32_t, CpuCore> cores;
+    std::map<uint32_t, uint32_t> clusters;
+    std::set<uint32_t> nodes;
+    for (uint32_t cpu : online) {
+        const fs::path cpu_dir = p_root / "cpu" / std::format("cpu{}", cpu);
+
+        std::vector<uint32_t> siblings = ParseCpuList(ReadLine(cpu_dir / "topology" / "thread_siblings_list"));
+        const uint32_t core_key = siblings.empty() ? cpu : siblings.front();
+
+        CpuCore& core = cores[core_key];
+        if (core.logicalIds.empty()) {
+            ReadUint(cpu_dir / "topology" / "physical_package_id", core.package);
+
+            auto node = numa_nodes.find(cpu);
+            core.numaNode = node == numa_nodes.end() ? 0 : node->second;
+            nodes.insert(core.numaNode);
+
+            const std::vector<uint32_t> cache = ReadLastLevelCache(cpu_dir);
+            // without cache info, assume the package shares one cache
+            const uint32_t cluster_key = cache.empty() ? 0x80000000u | core.package : cache.front();
+            auto cluster = clusters.try_emplace(cluster_key, static_cast<uint32_t>(clusters.size())).first;
+            core.cacheCluster = cluster->second;
+        }
+        core.logicalIds.push_back(cpu);
+    }
+
+    topology.cores.reserve(cores.size());
+    for (auto& [key, core] : cores) {
+        topology.cores.emplace_back(std::move(core));
+    }
+    std::sort(topology.cores.begin(), topology.cores.end(), [](const CpuCore& p_lhs, const CpuCore& p_rhs) {
+        if (p_lhs.numaNode != p_rhs.numaNode) {
+            return p_lhs.numaNode < p_rhs.numaNode;
+        }
+        if (p_lhs.cacheCluster != p_rhs.cacheCluster) {
+            return p_lhs.cacheCluster < p_rhs.cacheCluster;
+        }
+        return p_lhs.logicalIds.front() < p_rhs.logicalIds.front();
+    });
+
+    topology.logicalCount = static_cast<uint32_t>(online.size());
+    topology.numaNodeCount = static_cast<uint32_t>(nodes.size());
+    topology.cacheClusterCount = static_cast<uint32_t>(clusters.size());
+    topology.detected = true;
+    return topology;
+}
+
+CpuTopology DetectCpuTopology() {
+#if USING(PLATFORM_LINUX)
+    if (CpuTopology topology = ReadSysfsTopology("/sys/devices/system"); topology.detected) {
+        return topology;
+    }
+#endif
+
+    // @TODO: GetLogicalProcessorInformationEx on Windows, sysctl on Apple
+    CpuTopology topology;
+    topology.logicalCount = std::max(std::thread::hardware_concurrency(), 1u);
+    topology.cores.resize(topology.logicalCount);
+    for (uint32_t cpu = 0; cpu < topology.logicalCount; ++cpu) {
+        topology.cores[cpu].logicalIds.push_back(cpu);
+    }
+    return topology;
+}
+
+}  // namespace my
@@ -0,0 +1,32 @@
+#pragma once
+
+namespace my {
+
+struct CpuCore {
+    // logical processors of the core, more than one with SMT
+    std::vector<uint32_t> logicalIds;
+    uint32_t package = 0;
+    uint32_t numaNode = 0;
+    // cores sharing the last level cache are in the same cluster
+    uint32_t cacheCluster = 0;
+};
+
+struct CpuTopology {
+    // physical cores, ordered by numa node, then cache cluster, then first logical id
+    std::vector<CpuCore> cores;
+    uint32_t logicalCount = 0;
+    uint32_t numaNodeCount = 1;
+    uint32_t cacheClusterCount = 1;
+    // false when the system couldn't be queried, every logical processor is then reported as a core
+    bool detected = false;
+};
+
+CpuTopology DetectCpuTopology();
+
+// reads the topology from sysfs, p_root is usually /sys/devices/system
+CpuTopology ReadSysfsTopology(const std::filesystem::path& p_root);
+
+// parses the cpu lists sysfs uses, like "0-3,8,10-11", returns an empty list if malformed
+std::vector<uint32_t> ParseCpuList(std::string_view p_list);
+
+}  // namespace my
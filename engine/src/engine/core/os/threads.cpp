@@ -4,39 +4,113 @@
 #include <thread>
 
 #include "engine/core/debugger/profiler.h"
-#include "engine/core/framework/asset_manager.h"
 #include "engine/core/io/print.h"
+#include "engine/core/os/cpu_topology.h"
 #include "engine/drivers/windows/win32_prerequisites.h"
 #include "engine/systems/job_system/job_system.h"
 
+#if USING(PLATFORM_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 namespace my::thread {
 
 using ThreadMainFunc = void (*)();
 
 struct ThreadObject {
-    const char* name;
+    std::string name;
     ThreadMainFunc threadFunc;
     uint32_t id{ 0 };
+    std::vector<uint32_t> affinity{};
     std::thread threadObject{};
 };
 
 static thread_local uint32_t g_threadId;
 static struct {
     std::atomic_bool shutdownRequested;
-    std::array<ThreadObject, THREAD_MAX> threads = {
-#define THREAD_DEFINE(ENUM, FUNC) ThreadObject{ #ENUM, FUNC },
-        THREAD_LIST
-#undef THREAD_DEFINE
-    };
+    uint32_t jobWorkerCount;
+    // index 0 is the main thread, never resized once the threads run, the profiler keeps the names
+    std::vector<ThreadObject> threads;
 } s_threadGlob;
 
-bool Initialize() {
+ThreadLayout ComputeThreadLayout(const CpuTopology& p_topology, const ThreadConfig& p_config) {
+    const uint32_t core_count = std::max(static_cast<uint32_t>(p_topology.cores.size()), 1u);
+
+    ThreadLayout layout;
+    if (p_config.jobWorkerCount > 0) {
+        layout.jobWorkerCount = std::min(static_cast<uint32_t>(p_config.jobWorkerCount), MAX_JOB_WORKER_COUNT);
+    } else {
+        layout.jobWorkerCount = std::clamp(core_count - 1, 1u, MAX_JOB_WORKER_COUNT);
+    }
+
+    // a guessed topology can report SMT siblings as cores, pinning would then put two workers on one core
+    if (p_config.pinJobWorkers && p_topology.detected && core_count > 1) {
+        layout.jobWorkerAffinity.resize(layout.jobWorkerCount);
+        // cores are ordered by numa node and cache cluster, so workers fill the main thread's node first.
+        // Workers past the core count are oversubscribed on purpose and left unpinned.
+        const uint32_t pinned_count = std::min(layout.jobWorkerCount, core_count - 1);
+        for (uint32_t i = 0; i < pinned_count; ++i) {
+            layout.jobWorkerAffinity[i] = p_topology.cores[i + 1].logicalIds;
+        }
+    }
+
+    return layout;
+}
+
+static void SetAffinity(ThreadObject& p_object) {
+    if (p_object.affinity.empty()) {
+        return;
+    }
+
+#if USING(PLATFORM_LINUX)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (uint32_t cpu : p_object.affinity) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    if (int err = pthread_setaffinity_np(p_object.threadObject.native_handle(), sizeof(set), &set); err != 0) {
+        LOG_WARN("[threads] failed to set affinity of thread '{}', error {}", p_object.name, err);
+    }
+#elif USING(PLATFORM_WINDOWS)
+    DWORD_PTR mask = 0;
+    for (uint32_t cpu : p_object.affinity) {
+        if (cpu < 64) {
+            mask |= 1ull << cpu;
+        }
+    }
+    HANDLE handle = (HANDLE)p_object.threadObject.native_handle();
+    if (!SetThreadAffinityMask(handle, mask)) {
+        LOG_WARN("[threads] failed to set affinity of thread '{}'", p_object.name);
+    }
+#endif
+}
+
+bool Initialize(const ThreadLayout& p_layout) {
     g_threadId = THREAD_MAIN;
 
-    std::latch latch{ THREAD_MAX - 1 };
+    // the threads can be started again once Finailize() joined them
+    s_threadGlob.shutdownRequested = false;
+    s_threadGlob.jobWorkerCount = p_layout.jobWorkerCount;
+
+    auto& threads = s_threadGlob.threads;
+    threads.clear();
+    threads.reserve(1 + p_layout.jobWorkerCount);
+    threads.emplace_back(ThreadObject{ "THREAD_MAIN", []() {} });
+    for (uint32_t i = 0; i < p_layout.jobWorkerCount; ++i) {
+        ThreadObject& thread = threads.emplace_back(ThreadObject{ std::format("THREAD_JOBSYSTEM_WORKER_{}", i + 1), jobsystem::WorkerMain });
+        if (i < p_layout.jobWorkerAffinity.size()) {
+            thread.affinity = p_layout.jobWorkerAffinity[i];
+        }
+    }
+
+    const uint32_t thread_count = static_cast<uint32_t>(threads.size());
+    std::latch latch{ thread_count - 1 };
 
-    for (uint32_t id = THREAD_MAIN + 1; id < THREAD_MAX; ++id) {
-        ThreadObject& thread = s_threadGlob.threads[id];
+    for (uint32_t id = THREAD_MAIN + 1; id < thread_count; ++id) {
+        ThreadObject& thread = threads[id];
         thread.id = id;
         thread.threadObject = std::thread(
             [&](ThreadObject* p_object) {
@@ -45,21 +119,17 @@ bool Initialize() {
 
                 latch.count_down();
                 LOG_VERBOSE("[threads] thread '{}'(id: {}) starts.", p_object->name, p_object->id);
-                HBN_PROFILE_THREAD(p_object->name);
+                HBN_PROFILE_THREAD(p_object->name.c_str());
                 p_object->threadFunc();
                 LOG_VERBOSE("[threads] thread '{}'(id: {}) ends.", p_object->name, p_object->id);
             },
             &thread);
 
+        SetAffinity(thread);
+
 #if USING(PLATFORM_WINDOWS)
         HANDLE handle = (HANDLE)thread.threadObject.native_handle();
-
-        // @TODO: set thread affinity
-        // DWORD_PTR affinityMask = 1ull << threadID;
-        // DWORD_PTR affinityResult = SetThreadAffinityMask(handle, affinityMask);
-
-        std::string name = thread.name;
-        std::wstring wname(name.begin(), name.end());
+        std::wstring wname(thread.name.begin(), thread.name.end());
         HRESULT hr = SetThreadDescription(handle, wname.c_str());
         DEV_ASSERT(!FAILED(hr));
 #endif
@@ -70,7 +140,7 @@ bool Initialize() {
 }
 
 void Finailize() {
-    for (uint32_t id = THREAD_MAIN + 1; id < THREAD_MAX; ++id) {
+    for (uint32_t id = THREAD_MAIN + 1; id < s_threadGlob.threads.size(); ++id) {
         auto& thread = s_threadGlob.threads[id].threadObject;
         if (thread.joinable()) {
             thread.join();
@@ -84,8 +154,6 @@ bool ShutdownRequested() {
 
 void RequestShutdown() {
     s_threadGlob.shutdownRequested = true;
-    AssetManager::RequestShutdown();
-    // wake up
 }
 
 bool IsMainThread() {
@@ -96,4 +164,15 @@ uint32_t GetThreadId() {
     return g_threadId;
 }
 
+uint32_t GetJobWorkerCount() {
+    return s_threadGlob.jobWorkerCount;
+}
+
+int GetJobWorkerIndex() {
+    if (g_threadId == THREAD_MAIN || g_threadId > s_threadGlob.jobWorkerCount) {
+        return -1;
+    }
+    return static_cast<int>(g_threadId - 1);
+}
+
 }  // namespace my::thread
@@ -1,30 +1,36 @@
 #pragma once
 
-namespace my::thread {
+namespace my {
+struct CpuTopology;
+}  // namespace my
 
-#define THREAD_LIST                                                 \
-    THREAD_DEFINE(THREAD_MAIN, []() {})                             \
-    THREAD_DEFINE(THREAD_ASSET_LOADER_1, AssetManager::WorkerMain)  \
-    THREAD_DEFINE(THREAD_ASSET_LOADER_2, AssetManager::WorkerMain)  \
-    THREAD_DEFINE(THREAD_ASSET_LOADER_3, AssetManager::WorkerMain)  \
-    THREAD_DEFINE(THREAD_ASSET_LOADER_4, AssetManager::WorkerMain)  \
-    THREAD_DEFINE(THREAD_JOBSYSTEM_WORKER_1, jobsystem::WorkerMain) \
-    THREAD_DEFINE(THREAD_JOBSYSTEM_WORKER_2, jobsystem::WorkerMain) \
-    THREAD_DEFINE(THREAD_JOBSYSTEM_WORKER_3, jobsystem::WorkerMain) \
-    THREAD_DEFINE(THREAD_JOBSYSTEM_WORKER_4, jobsystem::WorkerMain) \
-    THREAD_DEFINE(THREAD_JOBSYSTEM_WORKER_5, jobsystem::WorkerMain) \
-    THREAD_DEFINE(THREAD_JOBSYSTEM_WORKER_6, jobsystem::WorkerMain) \
-    THREAD_DEFINE(THREAD_JOBSYSTEM_WORKER_7, jobsystem::WorkerMain) \
-    THREAD_DEFINE(THREAD_JOBSYSTEM_WORKER_8, jobsystem::WorkerMain)
+namespace my::thread {
 
+// The main thread is 0, followed by the job workers.
 enum ThreadID : uint32_t {
-#define THREAD_DEFINE(ENUM, ...) ENUM,
-    THREAD_LIST
-#undef THREAD_DEFINE
-        THREAD_MAX,
+    THREAD_MAIN = 0,
+};
+
+inline constexpr uint32_t MAX_JOB_WORKER_COUNT = 256;
+
+struct ThreadConfig {
+    // 0 sizes the pool from the cpu topology
+    int jobWorkerCount = 0;
+    bool pinJobWorkers = true;
 };
 
-bool Initialize();
+struct ThreadLayout {
+    uint32_t jobWorkerCount = 0;
+    // logical processors each job worker is pinned to, an empty list leaves the worker to the scheduler
+    std::vector<std::vector<uint32_t>> jobWorkerAffinity;
+};
+
+// The main thread keeps the first physical core and every other core gets one job worker. Background work
+// like asset loading runs on the workers too, see JOB_PRIORITY_BACKGROUND.
+ThreadLayout ComputeThreadLayout(const CpuTopology& p_topology, const ThreadConfig& p_config);
+
+// clears a previous shutdown request
+bool Initialize(const ThreadLayout& p_layout);
 
 void Finailize();
 
@@ -36,4 +42,9 @@ bool IsMainThread();
 
 uint32_t GetThreadId();
 
+uint32_t GetJobWorkerCount();
+
+// -1 if the calling thread is not a job worker
+int GetJobWorkerIndex();
+
 }  // namespace my::thread
@@ -0,0 +1,53 @@
+#include "string_id.h"
+
+#include <shared_mutex>
+
+#include "engine/core/base/linear_arena.h"
+
+namespace my {
+
+struct InternTable {
+    std::shared_mutex lock;
+    // owns the characters, never reset
+    LinearArena arena{ 64 * 1024 };
+    std::unordered_map<uint64_t, std::string_view> strings;
+};
+
+// names may be interned while other globals are constructed
+static InternTable& GetTable() {
+    static InternTable s_table;
+    return s_table;
+}
+
+StringId StringId::Intern(std::string_view p_string) {
+    InternTable& table = GetTable();
+    const StringId id(p_string);
+    {
+        std::shared_lock lock(table.lock);
+        auto it = table.strings.find(id.m_hash);
+        if (it != table.strings.end()) {
+            DEV_ASSERT_MSG(it->second == p_string, "string id collision");
+            return id;
+        }
+    }
+
+    std::unique_lock lock(table.lock);
+    auto [it, inserted] = table.strings.try_emplace(id.m_hash);
+    if (inserted) {
+        char* characters = table.arena.AllocateArray<char>(p_string.size() + 1);
+        memcpy(characters, p_string.data(), p_string.size());
+        characters[p_string.size()] = '\0';
+        it->second = std::string_view(characters, p_string.size());
+    }
+    DEV_ASSERT_MSG(it->second == p_string, "string id collision");
+    return id;
+}
+
+std::string_view StringId::GetString() const {
+    InternTable& table = GetTable();
+    std::shared_lock lock(table.lock);
+    auto it = table.strings.find(m_hash);
+    return it == table.strings.end() ? std::string_view() : it->second;
+}
+
+}  // namespace my
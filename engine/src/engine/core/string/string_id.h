@@ -0,0 +1,53 @@
+#pragma once
+
+namespace my {
+
+// 64-bit FNV-1a
+constexpr uint64_t HashString(std::string_view p_string) {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : p_string) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Compact handle of a string, compared and hashed as an integer. The id is the hash of the string, so the
+// same string always gives the same id, on every thread and at compile time:
+//   static constexpr StringId s_camera("main_camera");
+// Intern() also records the string, GetString() only knows about interned ones.
+class StringId {
+public:
+    constexpr StringId() = default;
+
+    constexpr explicit StringId(std::string_view p_string) : m_hash(HashString(p_string)) {}
+
+    // thread safe, the interned strings live until exit
+    static StringId Intern(std::string_view p_string);
+
+    // empty if the string was never interned
+    std::string_view GetString() const;
+
+    constexpr uint64_t GetHash() const { return m_hash; }
+
+    constexpr bool IsValid() const { return m_hash != 0; }
+
+    constexpr bool operator==(const StringId& p_rhs) const = default;
+    constexpr auto operator<=>(const StringId& p_rhs) const = default;
+
+private:
+    uint64_t m_hash = 0;
+};
+
+}  // namespace my
+
+namespace std {
+
+template<>
+struct hash<my::StringId> {
+    std::size_t operator()(const my::StringId& p_id) const {
+        return static_cast<std::size_t>(p_id.GetHash());
+    }
+};
+
+}  // namespace std
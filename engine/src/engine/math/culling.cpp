@@ -0,0 +1,270 @@
+#include "culling.h"
+
+#include "engine/math/frustum.h"
+
+namespace my {
+
+void CullingBounds::Clear() {
+    m_size = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        m_centers[axis].clear();
+        m_extents[axis].clear();
+    }
+}
+
+void CullingBounds::Reserve(uint32_t p_count) {
+    const uint32_t padded = (p_count + BATCH_SIZE - 1) / BATCH_SIZE * BATCH_SIZE;
+    for (int axis = 0; axis < 3; ++axis) {
+        m_centers[axis].reserve(padded);
+        m_extents[axis].reserve(padded);
+    }
+}
+
+uint32_t CullingBounds::Add(const AABB& p_aabb) {
+    if (m_size % BATCH_SIZE == 0) {
+        for (int axis = 0; axis < 3; ++axis) {
+            m_centers[axis].resize(m_size + BATCH_SIZE, 0.0f);
+            m_extents[axis].resize(m_size + BATCH_SIZE, 0.0f);
+        }
+    }
+
+    const Vector3f center = p_aabb.Center();
+    const Vector3f extent = 0.5f * p_aabb.Size();
+    for (int axis = 0; axis < 3; ++axis) {
+        m_centers[axis][m_size] = center[axis];
+        m_extents[axis][m_size] = extent[axis];
+    }
+    return m_size++;
+}
+
+uint32_t CullingBounds::Add(const AABB& p_local_aabb, const Matrix4x4f& p_world_matrix) {
+    const Vector3f center = p_local_aabb.Center();
+    const Vector3f extent = 0.5f * p_local_aabb.Size();
+
+    // the extent along a world axis is the extent of the box projected on that axis
+    Vector3f world_center;
+    Vector3f world_extent;
+    for (int row = 0; row < 3; ++row) {
+        world_center[row] = p_world_matrix[3][row];
+        world_extent[row] = 0.0f;
+        for (int col = 0; col < 3; ++col) {
+            world_center[row] += p_world_matrix[col][row] * center[col];
+            world_extent[row] += std::abs(p_world_matrix[col][row]) * extent[col];
+        }
+    }
+
+    return Add(AABB(world_center - world_extent, world_center + world_extent));
+}
+
+AABB CullingBounds::GetAabb(uint32_t p_index) const {
+    DEV_ASSERT_INDEX(p_index, m_size);
+    const Vector3f center(m_centers[0][p_index], m_centers[1][p_index], m_centers[2][p_index]);
+    const Vector3f extent(m_extents[0][p_index], m_extents[1][p_index], m_extents[2][p_index]);
+    return AABB(center - extent, center + extent);
+}
+
+// A box is outside a plane if its corner furthest along the normal is behind it. That corner is at
+// distance dot(n, c) + d + dot(abs(n), e), which is what Frustum::Intersects() tests one box at a time.
+void CullingBounds::CullFrustum(const Frustum& p_frustum, std::vector<uint8_t>& p_out_visible) const {
+    const uint32_t padded_size = static_cast<uint32_t>(m_centers[0].size());
+    p_out_visible.resize(padded_size);
+
+    struct PlaneData {
+        float normal[3];
+        float absNormal[3];
+        float dist;
+    };
+    std::array<PlaneData, 6> planes;
+    for (int i = 0; i < 6; ++i) {
+        const Plane& plane = p_frustum[i];
+        for (int axis = 0; axis < 3; ++axis) {
+            planes[i].normal[axis] = plane.normal[axis];
+            planes[i].absNormal[axis] = std::abs(plane.normal[axis]);
+        }
+        planes[i].dist = plane.dist;
+    }
+
+    const float* cx = m_centers[0].data();
+    const float* cy = m_centers[1].data();
+    const float* cz = m_centers[2].data();
+    const float* ex = m_extents[0].data();
+    const float* ey = m_extents[1].data();
+    const float* ez = m_extents[2].data();
+    uint8_t* out = p_out_visible.data();
+
+#if USING(MATH_ENABLE_SIMD_AVX)
+    const __m256 zero = _mm256_setzero_ps();
+    for (uint32_t i = 0; i < padded_size; i += 8) {
+        const __m256 center_x = _mm256_loadu_ps(cx + i);
+        const __m256 center_y = _mm256_loadu_ps(cy + i);
+        const __m256 center_z = _mm256_loadu_ps(cz + i);
+        const __m256 extent_x = _mm256_loadu_ps(ex + i);
+        const __m256 extent_y = _mm256_loadu_ps(ey + i);
+        const __m256 extent_z = _mm256_loadu_ps(ez + i);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (const PlaneData& plane : planes) {
+            __m256 dist = _mm256_set1_ps(plane.dist);
+            dist = _mm256_add_ps(dist, _mm256_mul_ps(center_x, _mm256_set1_ps(plane.normal[0])));
+            dist = _mm256_add_ps(dist, _mm256_mul_ps(center_y, _mm256_set1_ps(plane.normal[1])));
+            dist = _mm256_add_ps(dist, _mm256_mul_ps(center_z, _mm256_set1_ps(plane.normal[2])));
+            dist = _mm256_add_ps(dist, _mm256_mul_ps(extent_x, _mm256_set1_ps(plane.absNormal[0])));
+            dist = _mm256_add_ps(dist, _mm256_mul_ps(extent_y, _mm256_set1_ps(plane.absNormal[1])));
+            dist = _mm256_add_ps(dist, _mm256_mul_ps(extent_z, _mm256_set1_ps(plane.absNormal[2])));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, zero, _CMP_GE_OQ));
+            if (_mm256_testz_ps(inside, inside)) {
+                break;
+            }
+        }
+
+        const int mask = _mm256_movemask_ps(inside);
+        for (int lane = 0; lane < 8; ++lane) {
+            out[i + lane] = (mask >> lane) & 1;
+        }
+    }
+#elif USING(MATH_ENABLE_SIMD_SSE)
+    const __m128 zero = _mm_setzero_ps();
+    for (uint32_t i = 0; i < padded_size; i += 4) {
+        const __m128 center_x = _mm_loadu_ps(cx + i);
+        const __m128 center_y = _mm_loadu_ps(cy + i);
+        const __m128 center_z = _mm_loadu_ps(cz + i);
+        const __m128 extent_x = _mm_loadu_ps(ex + i);
+        const __m128 extent_y = _mm_loadu_ps(ey + i);
+        const __m128 extent_z = _mm_loadu_ps(ez + i);
+
+        __m128 inside = _mm_cmpeq_ps(zero, zero);
+        for (const PlaneData& plane : planes) {
+            __m128 dist = _mm_set1_ps(plane.dist);
+            dist = _mm_add_ps(dist, _mm_mul_ps(center_x, _mm_set1_ps(plane.normal[0])));
+            dist = _mm_add_ps(dist, _mm_mul_ps(center_y, _mm_set1_ps(plane.normal[1])));
+            dist = _mm_add_ps(dist, _mm_mul_ps(center_z, _mm_set1_ps(plane.normal[2])));
+            dist = _mm_add_ps(dist, _mm_mul_ps(extent_x, _mm_set1_ps(plane.absNormal[0])));
+            dist = _mm_add_ps(dist, _mm_mul_ps(extent_y, _mm_set1_ps(plane.absNormal[1])));
+            dist = _mm_add_ps(dist, _mm_mul_ps(extent_z, _mm_set1_ps(plane.absNormal[2])));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, zero));
+            if (_mm_movemask_ps(inside) == 0) {
+                break;
+            }
+        }
+
+        const int mask = _mm_movemask_ps(inside);
+        for (int lane = 0; lane < 4; ++lane) {
+            out[i + lane] = (mask >> lane) & 1;
+        }
+    }
+#elif USING(MATH_ENABLE_SIMD_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    for (uint32_t i = 0; i < padded_size; i += 4) {
+        const float32x4_t center_x = vld1q_f32(cx + i);
+        const float32x4_t center_y = vld1q_f32(cy + i);
+        const float32x4_t center_z = vld1q_f32(cz + i);
+        const float32x4_t extent_x = vld1q_f32(ex + i);
+        const float32x4_t extent_y = vld1q_f32(ey + i);
+        const float32x4_t extent_z = vld1q_f32(ez + i);
+
+        uint32x4_t inside = vdupq_n_u32(~0u);
+        for (const PlaneData& plane : planes) {
+            float32x4_t dist = vdupq_n_f32(plane.dist);
+            dist = vmlaq_n_f32(dist, center_x, plane.normal[0]);
+            dist = vmlaq_n_f32(dist, center_y, plane.normal[1]);
+            dist = vmlaq_n_f32(dist, center_z, plane.normal[2]);
+            dist = vmlaq_n_f32(dist, extent_x, plane.absNormal[0]);
+            dist = vmlaq_n_f32(dist, extent_y, plane.absNormal[1]);
+            dist = vmlaq_n_f32(dist, extent_z, plane.absNormal[2]);
+            inside = vandq_u32(inside, vcgeq_f32(dist, zero));
+            if (vmaxvq_u32(inside) == 0) {
+                break;
+            }
+        }
+
+        out[i + 0] = vgetq_lane_u32(inside, 0) & 1;
+        out[i + 1] = vgetq_lane_u32(inside, 1) & 1;
+        out[i + 2] = vgetq_lane_u32(inside, 2) & 1;
+        out[i + 3] = vgetq_lane_u32(inside, 3) & 1;
+    }
+#else
+    for (uint32_t i = 0; i < padded_size; ++i) {
+        bool inside = true;
+        for (const PlaneData& plane : planes) {
+            float dist = plane.dist;
+            dist += cx[i] * plane.normal[0] + cy[i] * plane.normal[1] + cz[i] * plane.normal[2];
+            dist += ex[i] * plane.absNormal[0] + ey[i] * plane.absNormal[1] + ez[i] * plane.absNormal[2];
+            if (dist < 0.0f) {
+                inside = false;
+                break;
+            }
+        }
+        out[i] = inside;
+    }
+#endif
+
+    p_out_visible.resize(m_size);
+}
+
+// Two boxes overlap if, on every axis, the distance between the centers is less than the sum of the extents.
+void CullingBounds::CullAabb(const AABB& p_aabb, std::vector<uint8_t>& p_out_visible) const {
+    const uint32_t padded_size = static_cast<uint32_t>(m_centers[0].size());
+    p_out_visible.resize(padded_size);
+
+    const Vector3f center = p_aabb.Center();
+    const Vector3f extent = 0.5f * p_aabb.Size();
+    uint8_t* out = p_out_visible.data();
+
+#if USING(MATH_ENABLE_SIMD_AVX)
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    for (uint32_t i = 0; i < padded_size; i += 8) {
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int axis = 0; axis < 3; ++axis) {
+            const __m256 dist = _mm256_andnot_ps(sign, _mm256_sub_ps(_mm256_loadu_ps(m_centers[axis].data() + i), _mm256_set1_ps(center[axis])));
+            const __m256 sum = _mm256_add_ps(_mm256_loadu_ps(m_extents[axis].data() + i), _mm256_set1_ps(extent[axis]));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, sum, _CMP_LT_OQ));
+        }
+
+        const int mask = _mm256_movemask_ps(inside);
+        for (int lane = 0; lane < 8; ++lane) {
+            out[i + lane] = (mask >> lane) & 1;
+        }
+    }
+#elif USING(MATH_ENABLE_SIMD_SSE)
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    for (uint32_t i = 0; i < padded_size; i += 4) {
+        __m128 inside = _mm_cmpeq_ps(sign, sign);
+        for (int axis = 0; axis < 3; ++axis) {
+            const __m128 dist = _mm_andnot_ps(sign, _mm_sub_ps(_mm_loadu_ps(m_centers[axis].data() + i), _mm_set1_ps(center[axis])));
+            const __m128 sum = _mm_add_ps(_mm_loadu_ps(m_extents[axis].data() + i), _mm_set1_ps(extent[axis]));
+            inside = _mm_and_ps(inside, _mm_cmplt_ps(dist, sum));
+        }
+
+        const int mask = _mm_movemask_ps(inside);
+        for (int lane = 0; lane < 4; ++lane) {
+            out[i + lane] = (mask >> lane) & 1;
+        }
+    }
+#elif USING(MATH_ENABLE_SIMD_NEON)
+    for (uint32_t i = 0; i < padded_size; i += 4) {
+        uint32x4_t inside = vdupq_n_u32(~0u);
+        for (int axis = 0; axis < 3; ++axis) {
+            const float32x4_t dist = vabsq_f32(vsubq_f32(vld1q_f32(m_centers[axis].data() + i), vdupq_n_f32(center[axis])));
+            const float32x4_t sum = vaddq_f32(vld1q_f32(m_extents[axis].data() + i), vdupq_n_f32(extent[axis]));
+            inside = vandq_u32(inside, vcltq_f32(dist, sum));
+        }
+
+        out[i + 0] = vgetq_lane_u32(inside, 0) & 1;
+        out[i + 1] = vgetq_lane_u32(inside, 1) & 1;
+        out[i + 2] = vgetq_lane_u32(inside, 2) & 1;
+        out[i + 3] = vgetq_lane_u32(inside, 3) & 1;
+    }
+#else
+    for (uint32_t i = 0; i < padded_size; ++i) {
+        bool inside = true;
+        for (int axis = 0; axis < 3; ++axis) {
+            inside = inside && std::abs(m_centers[axis][i] - center[axis]) < m_extents[axis][i] + extent[axis];
+        }
+        out[i] = inside;
+    }
+#endif
+
+    p_out_visible.resize(m_size);
+}
+
+}  // namespace my
@@ -0,0 +1,38 @@
+#pragma once
+#include "engine/math/aabb.h"
+
+namespace my {
+
+class Frustum;
+
+// World space boxes stored as centers and half extents, one array per axis, so a batch of boxes is tested
+// against a plane with a few vector instructions. The arrays are padded to a multiple of BATCH_SIZE, the
+// padding is never reported as visible.
+class CullingBounds {
+public:
+    static constexpr uint32_t BATCH_SIZE = 8;
+
+    void Clear();
+    void Reserve(uint32_t p_count);
+
+    // returns the index of the box
+    uint32_t Add(const AABB& p_aabb);
+    // adds p_local_aabb transformed by p_world_matrix, which is the same box AABB::ApplyMatrix() computes,
+    // without transforming the 8 corners
+    uint32_t Add(const AABB& p_local_aabb, const Matrix4x4f& p_world_matrix);
+
+    uint32_t GetSize() const { return m_size; }
+    AABB GetAabb(uint32_t p_index) const;
+
+    // p_out_visible[i] is 1 if box i intersects the frustum, 0 otherwise, same as Frustum::Intersects()
+    void CullFrustum(const Frustum& p_frustum, std::vector<uint8_t>& p_out_visible) const;
+    // same as AABB::Intersects(), boxes only touching p_aabb are not visible
+    void CullAabb(const AABB& p_aabb, std::vector<uint8_t>& p_out_visible) const;
+
+private:
+    uint32_t m_size = 0;
+    std::array<std::vector<float>, 3> m_centers;
+    std::array<std::vector<float>, 3> m_extents;
+};
+
+}  // namespace my
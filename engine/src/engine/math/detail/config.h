@@ -7,15 +7,25 @@
 #define MATH_ENABLE_SIMD_SSE  IN_USE
 #define MATH_ENABLE_SIMD_NEON NOT_IN_USE
 #include <xmmintrin.h>
+// AVX is only used where the compiler is allowed to emit it, there's no runtime dispatch
+#if defined(__AVX__)
+#define MATH_ENABLE_SIMD_AVX IN_USE
+#include <immintrin.h>
+#else  // #if defined(__AVX__)
+#define MATH_ENABLE_SIMD_AVX NOT_IN_USE
+#endif  // #else // #if defined(__AVX__)
 #elif USING(ARCH_ARM64)  // #if USING(ARCH_X64)
 #define MATH_ENABLE_SIMD_SSE  NOT_IN_USE
+#define MATH_ENABLE_SIMD_AVX  NOT_IN_USE
 #define MATH_ENABLE_SIMD_NEON IN_USE
 #include <arm_neon.h>
 #else  // #elif USING(ARCH_ARM64) // #if USING(ARCH_X64)
-#define MATH_ENABLE_SIMD_SSE NOT_IN_USE
-#define MATH_ENABLE_SIMD_AVX NOT_IN_USE
+#define MATH_ENABLE_SIMD_SSE  NOT_IN_USE
+#define MATH_ENABLE_SIMD_AVX  NOT_IN_USE
+#define MATH_ENABLE_SIMD_NEON NOT_IN_USE
 #endif  // #else // #elif USING(ARCH_ARM64) // #if USING(ARCH_X64)
 #else   // #if USING(MATH_ENABLE_SIMD)
-#define MATH_ENABLE_SIMD_SSE NOT_IN_USE
-#define MATH_ENABLE_SIMD_AVX NOT_IN_USE
+#define MATH_ENABLE_SIMD_SSE  NOT_IN_USE
+#define MATH_ENABLE_SIMD_AVX  NOT_IN_USE
+#define MATH_ENABLE_SIMD_NEON NOT_IN_USE
 #endif  // #else // #if USING(MATH_ENABLE_SIMD)
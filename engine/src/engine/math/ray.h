@@ -12,6 +12,10 @@ public:
 
     Vector3f Direction() const;
 
+    const Vector3f& GetStart() const { return m_start; }
+    const Vector3f& GetEnd() const { return m_end; }
+    float GetDist() const { return m_dist; }
+
     bool Intersects(const AABB& p_aabb) { return TestIntersection::RayAabb(p_aabb, *this); }
 
     bool Intersects(const Vector3f& p_a,
@@ -2,289 +2,311 @@
 
 #include <algorithm>
 
+#include "engine/core/debugger/profiler.h"
+#include "engine/systems/job_system/job_system.h"
+
 namespace my {
 
-using VertexList = std::vector<Vector3f>;
-using TriangleList = std::vector<Vector3i>;
+using jobsystem::Context;
+
+static constexpr int BIN_COUNT = 16;
+static constexpr float TRAVERSAL_COST = 0.125f;
+// nodes with at least this many primitives build their right subtree as a job
+static constexpr uint32_t PARALLEL_BUILD_THRESHOLD = 4096;
+static constexpr uint32_t PRIMITIVE_GROUP_SIZE = 1024;
 
-class BvhSorter;
+template<typename T>
+using BvhVector = memory::TaggedVector<T, memory::MEMORY_TAG_BVH>;
 
+// Binned SAH builder. All nodes work in place on ranges of a single primitive array, splitting
+// a node partitions its range, nothing is copied. Nodes are allocated in pairs from a preallocated
+// array, so subtrees can be built concurrently.
 class BvhBuilder {
 public:
-    BvhBuilder(const VertexList& p_vertices,
-               const TriangleList& p_triangles);
+    BvhBuilder(BvhVector<AABB>&& p_aabbs,
+               BvhVector<Vector3f>&& p_centroids,
+               BvhAccel& p_out_bvh);
 
-    BvhAccel::Ref ConstructHelper(const BvhAccel* p_parent, const std::vector<uint32_t>& p_indices) const;
-
-    uint32_t GetBVHCount() const {
-        return m_bvhCounter;
-    }
+    void Build();
 
 private:
-    BvhBuilder(const BvhBuilder&) = delete;
-
-    void SplitByAxis(BvhAccel* p_parent, const std::vector<uint32_t>& p_indices) const;
-    AABB AABBFromTriangles(const std::vector<uint32_t>& p_indices) const;
+    struct Split {
+        int axis = -1;
+        int bin = 0;
+        int binCount = 0;
+        float cost = std::numeric_limits<float>::infinity();
+    };
 
-    mutable uint32_t m_bvhCounter = 0;
-    const VertexList& m_vertices;
-    const TriangleList& m_triangles;
-    std::vector<AABB> m_aabbs;
-    std::vector<Vector3f> m_centroids;
+    void BuildNode(uint32_t p_node_index, uint32_t p_begin, uint32_t p_end, uint32_t p_depth);
 
-    friend class BvhSorter;
-};
+    Split FindSplit(uint32_t p_begin, uint32_t p_end, const AABB& p_centroid_box, float p_parent_area) const;
 
-class BvhSorter {
-public:
-    BvhSorter(int p_axis,
-              const BvhBuilder& p_builder) : m_axis(p_axis),
-                                             m_builder(p_builder) {}
-
-    bool operator()(uint32_t p_lhs, uint32_t p_rhs) const {
-        auto aabb_1 = m_builder.m_aabbs.at(p_lhs);
-        auto aabb_2 = m_builder.m_aabbs.at(p_rhs);
-        Vector3f center_1 = aabb_1.Center();
-        Vector3f center_2 = aabb_2.Center();
-        return center_1[m_axis] < center_2[m_axis];
+    static int BinIndex(float p_value, float p_min, float p_scale, int p_bin_count) {
+        return clamp(static_cast<int>((p_value - p_min) * p_scale), 0, p_bin_count - 1);
     }
 
-private:
-    const int m_axis;
-    const BvhBuilder& m_builder;
+    BvhVector<AABB> m_aabbs;
+    BvhVector<Vector3f> m_centroids;
+    BvhAccel& m_bvh;
+
+    std::atomic_uint32_t m_nodeCount;
 };
 
-BvhBuilder::BvhBuilder(const VertexList& p_vertices,
-                       const TriangleList& p_triangles) : m_vertices(p_vertices),
-                                                          m_triangles(p_triangles) {
-    m_aabbs.resize(m_triangles.size());
-    m_centroids.resize(m_triangles.size());
-    for (size_t i = 0; i < m_triangles.size(); ++i) {
-        const auto& triangle = m_triangles[i];
-        const Vector3f& a = m_vertices.at(triangle.x);
-        const Vector3f& b = m_vertices.at(triangle.y);
-        const Vector3f& c = m_vertices.at(triangle.z);
-        m_centroids[i] = (1.0f / 3.0f) * (a + b + c);
-        m_aabbs[i].MakeInvalid();
-        m_aabbs[i].ExpandPoint(a);
-        m_aabbs[i].ExpandPoint(b);
-        m_aabbs[i].ExpandPoint(c);
-        m_aabbs[i].MakeValid();
-    }
+BvhBuilder::BvhBuilder(BvhVector<AABB>&& p_aabbs,
+                       BvhVector<Vector3f>&& p_centroids,
+                       BvhAccel& p_out_bvh) : m_aabbs(std::move(p_aabbs)),
+                                              m_centroids(std::move(p_centroids)),
+                                              m_bvh(p_out_bvh),
+                                              m_nodeCount(0) {
+    DEV_ASSERT(m_aabbs.size() == m_centroids.size());
 }
 
-static int DominantAxis(const AABB& p_aabb) {
-    const Vector3f span = p_aabb.Size();
-    int axis = 0;
-    if (span[axis] < span.y) {
-        axis = 1;
+void BvhBuilder::Build() {
+    const uint32_t primitive_count = static_cast<uint32_t>(m_aabbs.size());
+    if (primitive_count == 0) {
+        return;
     }
-    if (span[axis] < span.z) {
-        axis = 2;
+
+    m_bvh.primitives.resize(primitive_count);
+    for (uint32_t i = 0; i < primitive_count; ++i) {
+        m_bvh.primitives[i] = i;
     }
+    // a binary tree with one primitive per leaf has 2n - 1 nodes, that's the upper bound
+    m_bvh.nodes.resize(2 * primitive_count - 1);
 
-    return axis;
+    m_nodeCount.store(1);
+    BuildNode(0, 0, primitive_count, 0);
+    m_bvh.nodes.resize(m_nodeCount.load());
 }
 
-AABB BvhBuilder::AABBFromTriangles(const std::vector<uint32_t>& p_indices) const {
-    AABB aabb;
-    for (uint32_t index : p_indices) {
-        const auto& points = m_triangles[index];
-        aabb.ExpandPoint(m_vertices[points.x]);
-        aabb.ExpandPoint(m_vertices[points.y]);
-        aabb.ExpandPoint(m_vertices[points.z]);
-    }
-    aabb.MakeValid();
-    return aabb;
-}
+BvhBuilder::Split BvhBuilder::FindSplit(uint32_t p_begin, uint32_t p_end, const AABB& p_centroid_box, float p_parent_area) const {
+    struct Bin {
+        AABB aabb;
+        uint32_t count = 0;
+    };
 
-void BvhBuilder::SplitByAxis(BvhAccel* p_parent,
-                             const std::vector<uint32_t>& p_indices) const {
-    auto indices = p_indices;
-    const int axis = DominantAxis(p_parent->aabb);
-    BvhSorter sorter(axis, *this);
-    std::sort(indices.begin(), indices.end(), sorter);
-    const size_t mid = indices.size() / 2;
-    std::vector<uint32_t> left(indices.begin(), indices.begin() + mid);
-    std::vector<uint32_t> right(indices.begin() + mid, indices.end());
-
-    p_parent->left = ConstructHelper(p_parent, left);
-    p_parent->right = ConstructHelper(p_parent, right);
-}
+    const uint32_t* primitives = m_bvh.primitives.data();
+    const float inv_parent_area = 1.0f / p_parent_area;
+    // small nodes don't need many bins, most of the time would go into sweeping empty ones
+    const int bin_count = std::min(BIN_COUNT, static_cast<int>(p_end - p_begin) + 1);
+
+    Split best;
+    for (int axis = 0; axis < 3; ++axis) {
+        const float min = p_centroid_box.GetMin()[axis];
+        const float extent = p_centroid_box.GetMax()[axis] - min;
+        if (extent <= 0.0f) {
+            continue;
+        }
 
-BvhAccel::Ref BvhBuilder::ConstructHelper(const BvhAccel* p_parent, const std::vector<uint32_t>& p_indices) const {
-    const int depth = p_parent ? p_parent->depth + 1 : 0;
-    if (depth > 64) {
-        CRASH_NOW_MSG("TOO MANY LEVELS OF BVH");
-        return nullptr;
-    }
+        const float scale = bin_count / extent;
+        std::array<Bin, BIN_COUNT> bins;
+        for (uint32_t i = p_begin; i < p_end; ++i) {
+            const uint32_t primitive = primitives[i];
+            Bin& bin = bins[BinIndex(m_centroids[primitive][axis], min, scale, bin_count)];
+            ++bin.count;
+            bin.aabb.UnionBox(m_aabbs[primitive]);
+        }
 
-    const int triangle_count = (int)p_indices.size();
-    const AABB parent_aabb = AABBFromTriangles(p_indices);
-    auto bvh = std::make_shared<BvhAccel>(m_bvhCounter++, p_parent);
-    bvh->aabb = parent_aabb;
-    bvh->depth = depth;
+        // sweep from the right first, so the left sweep can evaluate every split plane in one pass
+        std::array<float, BIN_COUNT - 1> right_areas;
+        std::array<uint32_t, BIN_COUNT - 1> right_counts;
+        AABB box;
+        uint32_t count = 0;
+        for (int i = bin_count - 1; i > 0; --i) {
+            box.UnionBox(bins[i].aabb);
+            count += bins[i].count;
+            right_areas[i - 1] = box.SurfaceArea();
+            right_counts[i - 1] = count;
+        }
 
-    if (triangle_count == 1) {
-        bvh->isLeaf = true;
-        bvh->triangleIndex = p_indices[0];
-        return bvh;
+        box.MakeInvalid();
+        count = 0;
+        for (int i = 0; i < bin_count - 1; ++i) {
+            box.UnionBox(bins[i].aabb);
+            count += bins[i].count;
+            if (count == 0 || right_counts[i] == 0) {
+                continue;
+            }
+
+            const float cost = TRAVERSAL_COST + (count * box.SurfaceArea() + right_counts[i] * right_areas[i]) * inv_parent_area;
+            if (cost < best.cost) {
+                best.axis = axis;
+                best.bin = i;
+                best.binCount = bin_count;
+                best.cost = cost;
+            }
+        }
     }
 
-    // @TODO: refactor
-    const float parent_surface = parent_aabb.SurfaceArea();
+    return best;
+}
+
+void BvhBuilder::BuildNode(uint32_t p_node_index, uint32_t p_begin, uint32_t p_end, uint32_t p_depth) {
+    uint32_t* primitives = m_bvh.primitives.data();
+    const uint32_t count = p_end - p_begin;
 
-    // @TODO rework
-    if (triangle_count <= 4 || parent_surface == 0.0f) {
-        DEV_ASSERT(parent_surface > 0.0f);
-        SplitByAxis(bvh.get(), p_indices);
-        return bvh;
+    AABB aabb;
+    AABB centroid_box;
+    for (uint32_t i = p_begin; i < p_end; ++i) {
+        aabb.UnionBox(m_aabbs[primitives[i]]);
+        centroid_box.ExpandPoint(m_centroids[primitives[i]]);
     }
 
-    constexpr int BUCKED_MAX = 12;
-    struct BucketInfo {
-        int count = 0;
-        AABB box;
-    };
-    std::array<BucketInfo, BUCKED_MAX> buckets;
+    // the node array never grows during the build, so the reference stays valid
+    BvhAccel::Node& node = m_bvh.nodes[p_node_index];
+    node.aabb = aabb;
+    node.offset = p_begin;
+    node.count = count;
 
-    AABB centroidBox;
-    for (const auto index : p_indices) {
-        const Vector3f& point = m_centroids.at(index);
-        centroidBox.ExpandPoint(point);
-    }
-    centroidBox.MakeValid();
-
-    const int axis = DominantAxis(centroidBox);
-    const float tmin = centroidBox.GetMin()[axis];
-    const float tmax = centroidBox.GetMax()[axis];
-
-    for (int index : p_indices) {
-        float tmp = ((m_centroids.at(index)[axis] - tmin) * BUCKED_MAX) / (tmax - tmin);
-        int slot = static_cast<int>(tmp);
-        slot = clamp(slot, 0, BUCKED_MAX - 1);
-        BucketInfo& bucket = buckets[slot];
-        ++bucket.count;
-        bucket.box.UnionBox(m_aabbs.at(index));
+    if (count == 1 || p_depth + 1 >= BvhAccel::MAX_DEPTH) {
+        return;
     }
 
-    float costs[BUCKED_MAX - 1];
-    for (int i = 0; i < BUCKED_MAX - 1; ++i) {
-        AABB b0, b1;
-        int count0 = 0, count1 = 0;
-        for (int j = 0; j <= i; ++j) {
-            b0.UnionBox(buckets[j].box);
-            count0 += buckets[j].count;
-        }
-        for (int j = i + 1; j < BUCKED_MAX; ++j) {
-            b1.UnionBox(buckets[j].box);
-            count1 += buckets[j].count;
+    const float parent_area = aabb.SurfaceArea();
+    const Split split = parent_area > 0.0f ? FindSplit(p_begin, p_end, centroid_box, parent_area) : Split();
+
+    uint32_t mid = p_begin + count / 2;
+    if (split.axis >= 0) {
+        // intersecting the primitives directly costs 1 per primitive
+        if (count <= BvhAccel::MAX_LEAF_SIZE && split.cost >= static_cast<float>(count)) {
+            return;
         }
 
-        constexpr float travCost = 0.125f;
-        costs[i] = travCost + (count0 * b0.SurfaceArea() + count1 * b1.SurfaceArea()) / parent_surface;
+        const float min = centroid_box.GetMin()[split.axis];
+        const float scale = split.binCount / (centroid_box.GetMax()[split.axis] - min);
+        uint32_t* it = std::partition(primitives + p_begin, primitives + p_end, [&](uint32_t p_primitive) {
+            return BinIndex(m_centroids[p_primitive][split.axis], min, scale, split.binCount) <= split.bin;
+        });
+        mid = static_cast<uint32_t>(it - primitives);
+    } else if (count <= BvhAccel::MAX_LEAF_SIZE) {
+        // all centroids in the same spot, binning can't separate them
+        return;
     }
 
-    int splitIndex = 0;
-    float minCost = costs[splitIndex];
-    for (int i = 0; i < BUCKED_MAX - 1; ++i) {
-        // printf("cost of split after bucket %d is %f\n", i, costs[i]);
-        if (costs[i] < minCost) {
-            splitIndex = i;
-            minCost = costs[splitIndex];
-        }
-    }
+    DEV_ASSERT(mid > p_begin && mid < p_end);
 
-    // printf("split index is %d\n", splitIndex);
-
-    std::vector<uint32_t> leftPartition;
-    std::vector<uint32_t> rightPartition;
-
-    for (auto index : p_indices) {
-        const auto& t = m_centroids.at(index);
-        float tmp = (t[axis] - tmin) / (tmax - tmin);
-        tmp *= BUCKED_MAX;
-        int slot = static_cast<int>(tmp);
-        slot = glm::clamp(slot, 0, BUCKED_MAX - 1);
-        if (slot <= splitIndex) {
-            leftPartition.push_back(index);
-        } else {
-            rightPartition.push_back(index);
-        }
+    const uint32_t left = m_nodeCount.fetch_add(2);
+    node.offset = left;
+    node.count = 0;
+
+    if (count < PARALLEL_BUILD_THRESHOLD) {
+        BuildNode(left, p_begin, mid, p_depth + 1);
+        BuildNode(left + 1, mid, p_end, p_depth + 1);
+        return;
     }
 
-    bvh->left = ConstructHelper(bvh.get(), leftPartition);
-    bvh->right = ConstructHelper(bvh.get(), rightPartition);
+    Context ctx;
+    ctx.Dispatch(1, 1, [&](jobsystem::JobArgs) {
+        BuildNode(left + 1, mid, p_end, p_depth + 1);
+    });
+    BuildNode(left, p_begin, mid, p_depth + 1);
+    ctx.Wait();
+}
+
+BvhAccel::Ref BvhAccel::Construct(const std::vector<uint32_t>& p_indices,
+                                  const std::vector<Vector3f>& p_vertices) {
+    HBN_PROFILE_EVENT();
+
+    DEV_ASSERT(p_indices.size() % 3 == 0);
+
+    const uint32_t triangle_count = static_cast<uint32_t>(p_indices.size() / 3);
+    BvhVector<AABB> aabbs(triangle_count);
+    BvhVector<Vector3f> centroids(triangle_count);
+
+    Context ctx;
+    ctx.Dispatch(triangle_count, PRIMITIVE_GROUP_SIZE, [&](jobsystem::JobArgs p_args) {
+        const uint32_t i = p_args.jobIndex;
+        const Vector3f& a = p_vertices[p_indices[3 * i]];
+        const Vector3f& b = p_vertices[p_indices[3 * i + 1]];
+        const Vector3f& c = p_vertices[p_indices[3 * i + 2]];
+
+        aabbs[i].ExpandPoint(a);
+        aabbs[i].ExpandPoint(b);
+        aabbs[i].ExpandPoint(c);
+        aabbs[i].MakeValid();
+        centroids[i] = (1.0f / 3.0f) * (a + b + c);
+    });
+    ctx.Wait();
+
+    auto bvh = std::make_shared<BvhAccel>();
+    BvhBuilder builder(std::move(aabbs), std::move(centroids), *bvh);
+    builder.Build();
     return bvh;
 }
 
-void BvhAccel::DiscoverIdx() {
-    missIndex = -1;
+BvhAccel::Ref BvhAccel::Construct(const std::vector<AABB>& p_aabbs) {
+    HBN_PROFILE_EVENT();
 
-    // hit link (find right link)
-    for (const BvhAccel* cursor = parent; cursor; cursor = cursor->parent) {
-        if (cursor->right && cursor->right->index > index) {
-            missIndex = cursor->right->index;
-            break;
-        }
+    BvhVector<AABB> aabbs(p_aabbs.begin(), p_aabbs.end());
+    BvhVector<Vector3f> centroids(aabbs.size());
+    for (size_t i = 0; i < aabbs.size(); ++i) {
+        aabbs[i].MakeValid();
+        centroids[i] = aabbs[i].Center();
     }
 
-    // if it's a hit, then check the left child node
-    // if there's not left child, treat it as a miss, so next bounding box to check is the miss node
-    hitIndex = left ? left->index : missIndex;
+    auto bvh = std::make_shared<BvhAccel>();
+    BvhBuilder builder(std::move(aabbs), std::move(centroids), *bvh);
+    builder.Build();
+    return bvh;
 }
 
-void BvhAccel::FillGpuBvhAccel(std::vector<GpuPtBvh>& p_out) {
-    DiscoverIdx();
-    DEV_ASSERT(aabb.IsValid());
-
-    GpuPtBvh gpu_bvh;
-    gpu_bvh.min = aabb.GetMin();
-    gpu_bvh.max = aabb.GetMax();
-    gpu_bvh.hitIdx = hitIndex;
-    gpu_bvh.missIdx = missIndex;
-    gpu_bvh.leaf = !!isLeaf;
-    gpu_bvh.triangleIndex = -1;
-    if (isLeaf) {
-        DEV_ASSERT(triangleIndex != -1);
-        gpu_bvh.triangleIndex = triangleIndex;
+// number of gpu nodes of each subtree, leaves are expanded to one gpu node per triangle
+static uint32_t CountGpuNodes(const BvhAccel& p_bvh, uint32_t p_index, std::vector<uint32_t>& p_out_counts) {
+    const BvhAccel::Node& node = p_bvh.nodes[p_index];
+    uint32_t count = node.count;
+    if (!node.IsLeaf()) {
+        count = 1 + CountGpuNodes(p_bvh, node.offset, p_out_counts) + CountGpuNodes(p_bvh, node.offset + 1, p_out_counts);
     }
 
-    p_out.push_back(gpu_bvh);
-    if (!isLeaf) {
-        DEV_ASSERT(left && right);
-    }
-    if (left) {
-        left->FillGpuBvhAccel(p_out);
-    }
-    if (right) {
-        right->FillGpuBvhAccel(p_out);
-    }
+    p_out_counts[p_index] = count;
+    return count;
 }
 
-BvhAccel::Ref BvhAccel::Construct(const std::vector<uint32_t>& p_indices,
-                                  const VertexList& p_vertices) {
+// the gpu traverses the tree without a stack, in pre-order. A hit moves on to the next node,
+// a miss skips the subtree
+static void FillGpuNodes(const BvhAccel& p_bvh,
+                         const std::vector<uint32_t>& p_counts,
+                         uint32_t p_index,
+                         int p_miss_index,
+                         std::vector<GpuPtBvh>& p_out) {
+    const BvhAccel::Node& node = p_bvh.nodes[p_index];
 
-    const int index_count = (int)p_indices.size();
-    DEV_ASSERT(index_count % 3 == 0);
-    const int triangle_count = index_count / 3;
+    GpuPtBvh gpu_bvh;
+    gpu_bvh.min = node.aabb.GetMin();
+    gpu_bvh.max = node.aabb.GetMax();
+    gpu_bvh.missIdx = p_miss_index;
+
+    if (node.IsLeaf()) {
+        gpu_bvh.leaf = 1;
+        for (uint32_t i = 0; i < node.count; ++i) {
+            const bool is_last = i + 1 == node.count;
+            gpu_bvh.triangleIndex = static_cast<int>(p_bvh.primitives[node.offset + i]);
+            gpu_bvh.hitIdx = is_last ? p_miss_index : static_cast<int>(p_out.size()) + 1;
+            p_out.push_back(gpu_bvh);
+        }
+        return;
+    }
 
-    TriangleList triangles(triangle_count);
-    std::vector<uint32_t> triangle_indices(triangle_count);
+    const int self_index = static_cast<int>(p_out.size());
+    const int right_index = self_index + 1 + static_cast<int>(p_counts[node.offset]);
+    gpu_bvh.leaf = 0;
+    gpu_bvh.triangleIndex = -1;
+    gpu_bvh.hitIdx = self_index + 1;
+    p_out.push_back(gpu_bvh);
 
-    // @TODO: centroid?
-    for (int i = 0; i < index_count; i += 3) {
-        const int index = i / 3;
+    FillGpuNodes(p_bvh, p_counts, node.offset, right_index, p_out);
+    FillGpuNodes(p_bvh, p_counts, node.offset + 1, p_miss_index, p_out);
+}
 
-        const int a = p_indices[i];
-        const int b = p_indices[i + 1];
-        const int c = p_indices[i + 2];
-        triangles[index] = Vector3i(a, b, c);
-        triangle_indices[index] = index;
+void BvhAccel::FillGpuBvhAccel(std::vector<GpuPtBvh>& p_out) const {
+    if (IsEmpty()) {
+        return;
     }
 
-    BvhBuilder builder(p_vertices, triangles);
-    return builder.ConstructHelper(nullptr, triangle_indices);
+    std::vector<uint32_t> counts(nodes.size());
+    const uint32_t gpu_node_count = CountGpuNodes(*this, 0, counts);
+    p_out.reserve(p_out.size() + gpu_node_count);
+    FillGpuNodes(*this, counts, 0, -1, p_out);
 }
 
 }  // namespace my
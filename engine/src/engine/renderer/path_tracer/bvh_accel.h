@@ -1,5 +1,7 @@
 #pragma once
+#include "engine/core/debugger/memory_tracker.h"
 #include "engine/math/aabb.h"
+#include "engine/math/ray.h"
 #include "engine/math/vector.h"
 
 namespace my {
@@ -8,32 +10,115 @@ namespace my {
 
 namespace my {
 
+// Flat bounding volume hierarchy, over the triangles of a mesh or over arbitrary boxes.
+// nodes[0] is the root, the two children of a node are always next to each other.
 struct BvhAccel {
     using Ref = std::shared_ptr<BvhAccel>;
 
-    BvhAccel(int p_index,
-             const BvhAccel* p_parent) : index(p_index),
-                                         parent(p_parent) {}
+    static constexpr uint32_t MAX_DEPTH = 64;
+    static constexpr uint32_t MAX_LEAF_SIZE = 4;
 
-    void DiscoverIdx();
+    struct Node {
+        AABB aabb;
+        // interior node: index of the left child, the right child is at offset + 1
+        // leaf node: index of the first entry in primitives
+        uint32_t offset;
+        // number of primitives, 0 for interior nodes
+        uint32_t count;
 
-    AABB aabb;
+        bool IsLeaf() const { return count > 0; }
+    };
 
-    const int index;
-    const BvhAccel* parent;
+    memory::TaggedVector<Node, memory::MEMORY_TAG_BVH> nodes;
+    // primitive (triangle or box) indices, leaves reference a range of them
+    memory::TaggedVector<uint32_t, memory::MEMORY_TAG_BVH> primitives;
 
-    int triangleIndex{ -1 };
-    int hitIndex{ -1 };
-    int missIndex{ -1 };
-    int depth{ 0 };
-    Ref left{ nullptr };
-    Ref right{ nullptr };
-    bool isLeaf{ false };
+    bool IsEmpty() const { return nodes.empty(); }
+
+    // Visits the leaves hit by p_ray front to back. p_func(primitive) tests a primitive against p_ray and
+    // returns true if it hit, shortening the ray. Nodes further away than the closest hit are skipped.
+    template<typename FUNC>
+    bool Intersects(Ray& p_ray, FUNC&& p_func) const;
 
     static Ref Construct(const std::vector<uint32_t>& p_indices,
                          const std::vector<Vector3f>& p_vertices);
 
-    void FillGpuBvhAccel(std::vector<GpuPtBvh>& p_out);
+    static Ref Construct(const std::vector<AABB>& p_aabbs);
+
+    void FillGpuBvhAccel(std::vector<GpuPtBvh>& p_out) const;
+
+private:
+    // slab test against the segment of the ray, a ray starting inside the box hits it at 0
+    static bool IntersectsNode(const AABB& p_aabb, const Vector3f& p_start, const Vector3f& p_inv_dir, float p_dist, float& p_out_t) {
+        const Vector3f t0s = (p_aabb.GetMin() - p_start) * p_inv_dir;
+        const Vector3f t1s = (p_aabb.GetMax() - p_start) * p_inv_dir;
+        const Vector3f tsmaller = min(t0s, t1s);
+        const Vector3f tbigger = max(t0s, t1s);
+
+        const float tmin = max(0.0f, max(tsmaller.x, max(tsmaller.y, tsmaller.z)));
+        const float tmax = min(p_dist, min(tbigger.x, min(tbigger.y, tbigger.z)));
+        p_out_t = tmin;
+        return tmin <= tmax;
+    }
 };
 
+template<typename FUNC>
+bool BvhAccel::Intersects(Ray& p_ray, FUNC&& p_func) const {
+    if (IsEmpty()) {
+        return false;
+    }
+
+    const Vector3f& start = p_ray.GetStart();
+    const Vector3f inv_dir = 1.0f / (p_ray.GetEnd() - start);
+
+    struct StackEntry {
+        uint32_t index;
+        float t;
+    };
+    // only the far child is pushed, one entry per level at most
+    std::array<StackEntry, MAX_DEPTH> stack;
+    int top = 0;
+
+    float t_root;
+    if (!IntersectsNode(nodes[0].aabb, start, inv_dir, p_ray.GetDist(), t_root)) {
+        return false;
+    }
+
+    bool hit = false;
+    uint32_t index = 0;
+    for (;;) {
+        const Node& node = nodes[index];
+        if (node.IsLeaf()) {
+            for (uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+                hit |= p_func(primitives[i]);
+            }
+        } else {
+            float t_left, t_right;
+            const bool hit_left = IntersectsNode(nodes[node.offset].aabb, start, inv_dir, p_ray.GetDist(), t_left);
+            const bool hit_right = IntersectsNode(nodes[node.offset + 1].aabb, start, inv_dir, p_ray.GetDist(), t_right);
+            if (hit_left && hit_right) {
+                const bool left_first = t_left <= t_right;
+                stack[top++] = left_first ? StackEntry{ node.offset + 1, t_right } : StackEntry{ node.offset, t_left };
+                index = left_first ? node.offset : node.offset + 1;
+                continue;
+            }
+            if (hit_left || hit_right) {
+                index = hit_left ? node.offset : node.offset + 1;
+                continue;
+            }
+        }
+
+        // the ray might have been shortened since the node was pushed
+        while (top > 0 && stack[top - 1].t > p_ray.GetDist()) {
+            --top;
+        }
+        if (top == 0) {
+            break;
+        }
+        index = stack[--top].index;
+    }
+
+    return hit;
+}
+
 }  // namespace my
@@ -1,6 +1,7 @@
 #include "render_data.h"
 
 #include "engine/core/base/random.h"
+#include "engine/math/culling.h"
 #include "engine/math/frustum.h"
 #include "engine/math/matrix_transform.h"
 #include "engine/renderer/graphics_defines.h"
@@ -21,6 +22,17 @@ using my::Frustum;
 using FilterObjectFunc1 = std::function<bool(const ObjectComponent& p_object)>;
 using FilterObjectFunc2 = std::function<bool(const AABB& p_object_aabb)>;
 
+// World bounds of the objects are computed once per frame, every pass culls all of them in one go,
+// then only visits the visible ones.
+struct ObjectCullingData {
+    explicit ObjectCullingData(LinearArena& p_arena) : entities(p_arena) {}
+
+    CullingBounds bounds;
+    ArenaVector<ecs::Entity> entities;
+    // result of the last culling, one entry per object
+    std::vector<uint8_t> visible;
+};
+
 static void FillMaterialConstantBuffer(bool p_is_opengl, const MaterialComponent* p_material, MaterialConstantBuffer& cb) {
     cb.c_baseColor = p_material->baseColor;
     cb.c_metallic = p_material->metallic;
@@ -63,18 +75,40 @@ static void FillMaterialConstantBuffer(bool p_is_opengl, const MaterialComponent
     cb.c_hasMaterialMap = set_texture(MaterialComponent::TEXTURE_METALLIC_ROUGHNESS, cb.c_materialMapHandle, cb.c_MaterialMapResidentHandle);
 };
 
+static void FillObjectCullingData(const Scene& p_scene, ObjectCullingData& p_out_culling) {
+    p_out_culling.bounds.Clear();
+    p_out_culling.entities.clear();
+
+    const uint32_t count = static_cast<uint32_t>(p_scene.GetCount<ObjectComponent>());
+    p_out_culling.bounds.Reserve(count);
+    p_out_culling.entities.reserve(count);
+
+    for (auto [entity, obj, transform] : p_scene.View<ObjectComponent, TransformComponent>()) {
+        DEV_ASSERT(p_scene.Contains<MeshComponent>(obj.meshId));
+        const MeshComponent& mesh = *p_scene.GetComponent<MeshComponent>(obj.meshId);
+
+        p_out_culling.bounds.Add(mesh.localBound, transform.GetWorldMatrix());
+        p_out_culling.entities.emplace_back(entity);
+    }
+}
+
+// p_culling.visible has to be filled for the pass, p_filter2 culls the subsets of visible objects
 static void FillPass(const Scene& p_scene,
+                     const ObjectCullingData& p_culling,
                      PassContext& p_pass,
                      FilterObjectFunc1 p_filter1,
                      FilterObjectFunc2 p_filter2,
                      RenderData& p_out_render_data) {
+    DEV_ASSERT(p_culling.visible.size() == p_culling.entities.size());
 
     const bool is_opengl = p_out_render_data.options.isOpengl;
-    for (auto [entity, obj] : p_scene.m_ObjectComponents) {
-        if (!p_scene.Contains<TransformComponent>(entity)) {
+    for (size_t object_index = 0; object_index < p_culling.entities.size(); ++object_index) {
+        if (!p_culling.visible[object_index]) {
             continue;
         }
 
+        const ecs::Entity entity = p_culling.entities[object_index];
+        const ObjectComponent& obj = *p_scene.GetComponent<ObjectComponent>(entity);
         const bool is_transparent = obj.flags & ObjectComponent::FLAG_TRANSPARENT;
 
         if (!p_filter1(obj)) {
@@ -82,23 +116,18 @@ static void FillPass(const Scene& p_scene,
         }
 
         const TransformComponent& transform = *p_scene.GetComponent<TransformComponent>(entity);
-        DEV_ASSERT(p_scene.Contains<MeshComponent>(obj.meshId));
-
         const MeshComponent& mesh = *p_scene.GetComponent<MeshComponent>(obj.meshId);
         bool double_sided = mesh.flags & MeshComponent::DOUBLE_SIDED;
 
         const Matrix4x4f& world_matrix = transform.GetWorldMatrix();
-        AABB aabb = mesh.localBound;
-        aabb.ApplyMatrix(world_matrix);
-        if (!p_filter2(aabb)) {
-            continue;
-        }
+        // a single subset has the bound of the whole mesh, which already passed
+        const bool cull_subsets = mesh.subsets.size() > 1;
 
         PerBatchConstantBuffer batch_buffer;
         batch_buffer.c_worldMatrix = world_matrix;
         batch_buffer.c_meshFlag = mesh.armatureId.IsValid();
 
-        BatchContext draw;
+        BatchContext draw(p_out_render_data.arena);
         if (entity == p_scene.m_selected) {
             draw.flags = STENCIL_FLAG_SELECTED;
         }
@@ -130,10 +159,12 @@ static void FillPass(const Scene& p_scene,
         }
 
         for (const auto& subset : mesh.subsets) {
-            aabb = subset.local_bound;
-            aabb.ApplyMatrix(world_matrix);
-            if (!p_filter2(aabb)) {
-                continue;
+            if (cull_subsets) {
+                AABB aabb = subset.local_bound;
+                aabb.ApplyMatrix(world_matrix);
+                if (!p_filter2(aabb)) {
+                    continue;
+                }
             }
 
             const MaterialComponent* material = p_scene.GetComponent<MaterialComponent>(subset.material_id);
@@ -169,19 +200,23 @@ static void FillPass(const Scene& p_scene,
     }
 }
 
-static void DebugDrawBVH(int p_level, BvhAccel* p_bvh, const Matrix4x4f* p_matrix) {
-    if (!p_bvh || p_bvh->depth > p_level) {
+static void DebugDrawBVH(int p_level, const BvhAccel& p_bvh, uint32_t p_index, int p_depth, const Matrix4x4f* p_matrix) {
+    if (p_depth > p_level) {
         return;
     }
 
-    if (p_bvh->depth == p_level) {
-        renderer::AddDebugCube(p_bvh->aabb,
+    const BvhAccel::Node& node = p_bvh.nodes[p_index];
+    if (p_depth == p_level) {
+        renderer::AddDebugCube(node.aabb,
                                Color::HexRgba(0xFFFF0037),
                                p_matrix);
+        return;
     }
 
-    DebugDrawBVH(p_level, p_bvh->left.get(), p_matrix);
-    DebugDrawBVH(p_level, p_bvh->right.get(), p_matrix);
+    if (!node.IsLeaf()) {
+        DebugDrawBVH(p_level, p_bvh, node.offset, p_depth + 1, p_matrix);
+        DebugDrawBVH(p_level, p_bvh, node.offset + 1, p_depth + 1, p_matrix);
+    }
 };
 
 static void FillConstantBuffer(const Scene& p_scene, RenderData& p_out_data) {
@@ -287,16 +322,16 @@ static void FillConstantBuffer(const Scene& p_scene, RenderData& p_out_data) {
             const MeshComponent* mesh = p_scene.GetComponent<MeshComponent>(obj.meshId);
             const TransformComponent* transform = p_scene.GetComponent<TransformComponent>(id);
             if (mesh && transform) {
-                if (const auto& bvh = mesh->bvh; bvh) {
+                if (const auto& bvh = mesh->bvh; bvh && !bvh->IsEmpty()) {
                     const auto& matrix = transform->GetWorldMatrix();
-                    DebugDrawBVH(level, bvh.get(), &matrix);
+                    DebugDrawBVH(level, *bvh, 0, 0, &matrix);
                 }
             }
         }
     }
 }
 
-static void FillLightBuffer(const Scene& p_scene, RenderData& p_out_data) {
+static void FillLightBuffer(const Scene& p_scene, ObjectCullingData& p_culling, RenderData& p_out_data) {
 
     const uint32_t light_count = glm::min<uint32_t>((uint32_t)p_scene.GetCount<LightComponent>(), MAX_LIGHT_COUNT);
 
@@ -353,8 +388,10 @@ static void FillLightBuffer(const Scene& p_scene, RenderData& p_out_data) {
                 p_out_data.passCache.emplace_back(pass_constant);
 
                 Frustum light_frustum(light.projection_matrix * light.view_matrix);
+                p_culling.bounds.CullFrustum(light_frustum, p_culling.visible);
                 FillPass(
                     p_scene,
+                    p_culling,
                     p_out_data.shadowPasses[0],
                     [](const ObjectComponent& p_object) {
                         return p_object.flags & ObjectComponent::FLAG_CAST_SHADOW;
@@ -378,10 +415,12 @@ static void FillLightBuffer(const Scene& p_scene, RenderData& p_out_data) {
 
                     Vector3f radiance(light.max_distance);
                     AABB aabb = AABB::FromCenterSize(light.position, radiance);
-                    auto pass = std::make_unique<PassContext>();
+                    PassContext* pass = p_out_data.arena.New<PassContext>(p_out_data.arena);
+                    p_culling.bounds.CullAabb(aabb, p_culling.visible);
                     FillPass(
                         p_scene,
-                        *pass.get(),
+                        p_culling,
+                        *pass,
                         [](const ObjectComponent& p_object) {
                             return p_object.flags & ObjectComponent::FLAG_CAST_SHADOW;
                         },
@@ -399,7 +438,7 @@ static void FillLightBuffer(const Scene& p_scene, RenderData& p_out_data) {
                         point_shadow_cache[slot].c_pointLightFar = light_component.GetMaxDistance();
                     }
 
-                    p_out_data.pointShadowPasses[shadow_map_index] = std::move(pass);
+                    p_out_data.pointShadowPasses[shadow_map_index] = pass;
                 } else {
                     light.shadow_map_index = -1;
                 }
@@ -421,6 +460,7 @@ static void FillLightBuffer(const Scene& p_scene, RenderData& p_out_data) {
 }
 
 static void FillVoxelPass(const Scene& p_scene,
+                          ObjectCullingData& p_culling,
                           RenderData& p_out_data) {
     bool enabled = false;
     bool show_debug = false;
@@ -468,8 +508,10 @@ static void FillVoxelPass(const Scene& p_scene,
     cache.c_texelSize = texel_size;
     cache.c_voxelSize = voxel_size;
 
+    p_culling.bounds.CullAabb(voxel_gi_bound, p_culling.visible);
     FillPass(
         p_scene,
+        p_culling,
         p_out_data.voxelPass,
         [](const ObjectComponent& object) {
             return object.flags & ObjectComponent::FLAG_RENDERABLE;
@@ -481,6 +523,7 @@ static void FillVoxelPass(const Scene& p_scene,
 }
 
 static void FillMainPass(const Scene& p_scene,
+                         ObjectCullingData& p_culling,
                          RenderData& p_out_data) {
     const auto& camera = p_out_data.mainCamera;
     Frustum camera_frustum(camera.projectionMatrixFrustum * camera.viewMatrix);
@@ -493,8 +536,10 @@ static void FillMainPass(const Scene& p_scene,
     p_out_data.mainPass.pass_idx = static_cast<int>(p_out_data.passCache.size());
     p_out_data.passCache.emplace_back(pass_constant);
 
+    p_culling.bounds.CullFrustum(camera_frustum, p_culling.visible);
     FillPass(
         p_scene,
+        p_culling,
         p_out_data.mainPass,
         [](const ObjectComponent& object) {
             return object.flags & ObjectComponent::FLAG_RENDERABLE;
@@ -562,6 +607,8 @@ static void FillBloomConstants(const Scene& p_config,
 
 static void FillMeshEmitterBuffer(const Scene& p_scene,
                                   RenderData& p_out_data) {
+    // arena memory is only given back at the end of the frame, grow once
+    p_out_data.instances.reserve(p_scene.GetCount<MeshEmitterComponent>());
     for (auto [id, emitter] : p_scene.m_MeshEmitterComponents) {
         auto transform = p_scene.GetComponent<TransformComponent>(id);
         auto mesh = p_scene.GetComponent<MeshComponent>(emitter.meshId);
@@ -570,8 +617,6 @@ static void FillMeshEmitterBuffer(const Scene& p_scene,
             batch_buffer.c_worldMatrix = Matrix4x4f(1);
             batch_buffer.c_meshFlag = MESH_HAS_INSTANCE;
 
-            BatchContext draw;
-
             auto& position_buffer = p_out_data.boneCache.buffer;
 
             InstanceContext instance;
@@ -613,6 +658,10 @@ static void FillParticleEmitterBuffer(const Scene& p_scene,
     static int s_counter = -1;
     s_counter++;
 
+    const size_t count = p_scene.GetCount<ParticleEmitterComponent>();
+    p_out_data.emitterCache.reserve(count);
+    p_out_data.emitters.reserve(count);
+
     const auto view = p_scene.View<ParticleEmitterComponent>();
     for (auto [id, emitter] : view) {
         const uint32_t pre_sim_idx = emitter.GetPreIndex();
@@ -706,10 +755,13 @@ void PrepareRenderData(const PerspectiveCameraComponent& p_camera,
         }
     }
 
+    ObjectCullingData culling(p_out_data.arena);
+    FillObjectCullingData(p_scene, culling);
+
     FillConstantBuffer(p_scene, p_out_data);
-    FillLightBuffer(p_scene, p_out_data);
-    FillMainPass(p_scene, p_out_data);
-    FillVoxelPass(p_scene, p_out_data);
+    FillLightBuffer(p_scene, culling, p_out_data);
+    FillMainPass(p_scene, culling, p_out_data);
+    FillVoxelPass(p_scene, culling, p_out_data);
     FillMeshEmitterBuffer(p_scene, p_out_data);
     FillBloomConstants(p_scene, p_out_data);
     FillEnvConstants(p_scene, p_out_data);
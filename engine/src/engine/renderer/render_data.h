@@ -1,4 +1,5 @@
 #pragma once
+#include "engine/core/base/linear_arena.h"
 #include "engine/math/angle.h"
 #include "engine/math/geomath.h"
 #include "engine/renderer/gpu_resource.h"
@@ -33,11 +34,14 @@ struct DrawContext {
     int material_idx;
 };
 
+// Everything below lives in the frame arena of the renderer, containers included, see BeginFrame()
 struct BatchContext {
+    explicit BatchContext(LinearArena& p_arena) : subsets(p_arena) {}
+
     int bone_idx;
     int batch_idx;
     const GpuMesh* mesh_data;
-    std::vector<DrawContext> subsets;
+    ArenaVector<DrawContext> subsets;
     StencilFlags flags = STENCIL_FLAG_NONE;
 };
 
@@ -53,11 +57,13 @@ struct InstanceContext {
 };
 
 struct PassContext {
+    explicit PassContext(LinearArena& p_arena) : opaque(p_arena), transparent(p_arena), doubleSided(p_arena) {}
+
     int pass_idx{ 0 };
 
-    std::vector<BatchContext> opaque;
-    std::vector<BatchContext> transparent;
-    std::vector<BatchContext> doubleSided;
+    ArenaVector<BatchContext> opaque;
+    ArenaVector<BatchContext> transparent;
+    ArenaVector<BatchContext> doubleSided;
 };
 
 struct ImageDrawContext {
@@ -69,8 +75,10 @@ struct ImageDrawContext {
 
 template<typename BUFFER>
 struct BufferCache {
-    std::vector<BUFFER> buffer;
-    std::unordered_map<ecs::Entity, uint32_t> lookup;
+    explicit BufferCache(LinearArena& p_arena) : buffer(p_arena), lookup(p_arena) {}
+
+    ArenaVector<BUFFER> buffer;
+    ArenaUnorderedMap<ecs::Entity, uint32_t> lookup;
 
     uint32_t FindOrAdd(ecs::Entity p_entity, const BUFFER& p_buffer) {
         auto it = lookup.find(p_entity);
@@ -107,10 +115,28 @@ struct RenderData {
         Degree fovy;
     };
 
-    RenderData(const RenderOptions& p_options) : options(p_options) {
+    RenderData(const RenderOptions& p_options, LinearArena& p_arena)
+        : options(p_options),
+          arena(p_arena),
+          batchCache(p_arena),
+          materialCache(p_arena),
+          passCache(p_arena),
+          boneCache(p_arena),
+          emitterCache(p_arena),
+          shadowPasses{ PassContext(p_arena) },
+          voxelPass(p_arena),
+          mainPass(p_arena),
+          instances(p_arena),
+          emitters(p_arena),
+          updateBuffer(p_arena),
+          drawDebugContext{ ArenaVector<Vector3f>(p_arena), ArenaVector<Color>(p_arena), 0 },
+          drawImageContext(p_arena) {
+        pointShadowPasses.fill(nullptr);
     }
 
     const RenderOptions options;
+    // the frame arena everything is allocated from, reset once the frame is no longer in flight
+    LinearArena& arena;
 
     Camera mainCamera;
 
@@ -119,41 +145,43 @@ struct RenderData {
     PerFrameConstantBuffer perFrameCache;
     BufferCache<PerBatchConstantBuffer> batchCache;
     BufferCache<MaterialConstantBuffer> materialCache;
-    std::vector<PerPassConstantBuffer> passCache;
+    ArenaVector<PerPassConstantBuffer> passCache;
     std::array<PointShadowConstantBuffer, MAX_POINT_LIGHT_SHADOW_COUNT * 6> pointShadowCache;
     BufferCache<BoneConstantBuffer> boneCache;
-    std::vector<EmitterConstantBuffer> emitterCache;
+    ArenaVector<EmitterConstantBuffer> emitterCache;
 
     // @TODO: rename
-    std::array<std::unique_ptr<PassContext>, MAX_POINT_LIGHT_SHADOW_COUNT> pointShadowPasses;
+    // allocated from the arena for the lights that cast shadows, null otherwise
+    std::array<PassContext*, MAX_POINT_LIGHT_SHADOW_COUNT> pointShadowPasses;
     std::array<PassContext, 1> shadowPasses;  // @TODO: support multi ortho light
 
     PassContext voxelPass;
     PassContext mainPass;
 
-    std::vector<InstanceContext> instances;
+    ArenaVector<InstanceContext> instances;
 
-    std::vector<ParticleEmitterComponent> emitters;
+    ArenaVector<ParticleEmitterComponent> emitters;
 
     // @TODO: refactor
     bool bakeIbl;
     std::shared_ptr<GpuTexture> skyboxHdr;
 
+    // the vertices are moved over from the mesh, they keep their own memory
     struct UpdateBuffer {
         std::vector<Vector3f> positions;
         std::vector<Vector3f> normals;
         const void* id;
     };
 
-    std::vector<UpdateBuffer> updateBuffer;
+    ArenaVector<UpdateBuffer> updateBuffer;
 
     struct DrawDebugContext {
-        std::vector<Vector3f> positions;
-        std::vector<Color> colors;
+        ArenaVector<Vector3f> positions;
+        ArenaVector<Color> colors;
         uint32_t drawCount;
     } drawDebugContext;
 
-    std::vector<ImageDrawContext> drawImageContext;
+    ArenaVector<ImageDrawContext> drawImageContext;
     uint32_t drawImageOffset;
 };
 
@@ -38,7 +38,7 @@ struct RenderPassCreateInfo {
 };
 
 /// Gbuffer
-static void DrawBatchesGeometry(const RenderData& p_data, const std::vector<BatchContext>& p_batches, bool p_is_prepass) {
+static void DrawBatchesGeometry(const RenderData& p_data, const ArenaVector<BatchContext>& p_batches, bool p_is_prepass) {
     HBN_PROFILE_EVENT();
 
     auto& gm = GraphicsManager::GetSingleton();
@@ -78,7 +78,7 @@ static void DrawBatchesGeometry(const RenderData& p_data, const std::vector<Batc
 }
 
 // @TODO: generalize this
-static void DrawInstacedGeometry(const RenderData& p_data, const std::vector<InstanceContext>& p_instances, bool p_is_prepass) {
+static void DrawInstacedGeometry(const RenderData& p_data, const ArenaVector<InstanceContext>& p_instances, bool p_is_prepass) {
     unused(p_is_prepass);
 
     HBN_PROFILE_EVENT();
@@ -264,7 +264,7 @@ static void PointShadowPassFunc(const RenderData& p_data, const Framebuffer* p_f
     // prepare render data
     const auto [width, height] = p_framebuffer->GetBufferSize();
 
-    auto draw_batches = [&](const std::vector<BatchContext>& p_batches) {
+    auto draw_batches = [&](const ArenaVector<BatchContext>& p_batches) {
         for (const auto& draw : p_batches) {
             const bool has_bone = draw.bone_idx >= 0;
             if (has_bone) {
@@ -279,14 +279,14 @@ static void PointShadowPassFunc(const RenderData& p_data, const Framebuffer* p_f
     };
 
     for (int pass_id = 0; pass_id < MAX_POINT_LIGHT_SHADOW_COUNT; ++pass_id) {
-        auto& pass_ptr = p_data.pointShadowPasses[pass_id];
+        const PassContext* pass_ptr = p_data.pointShadowPasses[pass_id];
         if (!pass_ptr) {
             continue;
         }
 
-        const PassContext& pass = *pass_ptr.get();
+        const PassContext& pass = *pass_ptr;
         for (int face_id = 0; face_id < 6; ++face_id) {
-#if USING(USE_PROFILER)
+#if USING(USE_OPTICK)
             const auto event_name = std::format("point_shadow_pass_{}_{}", pass_id, face_id);
             auto desc = Optick::CreateDescription(OPTICK_FUNC,
                                                   __FILE__,
@@ -329,7 +329,7 @@ static void ShadowPassFunc(const RenderData& p_data, const Framebuffer* p_frameb
     const PassContext& pass = p_data.shadowPasses[0];
     gm.BindConstantBufferSlot<PerPassConstantBuffer>(frame.passCb.get(), pass.pass_idx);
 
-    auto draw_batches = [&](const std::vector<BatchContext>& p_batches) {
+    auto draw_batches = [&](const ArenaVector<BatchContext>& p_batches) {
         for (const auto& draw : p_batches) {
             const bool has_bone = draw.bone_idx >= 0;
             if (has_bone) {
@@ -425,7 +425,7 @@ static void VoxelizationPassFunc(const RenderData& p_data, const Framebuffer*) {
 
     // @TODO: hack
     if (gm.GetBackend() == Backend::OPENGL) {
-        auto draw_batches = [&](const std::vector<BatchContext>& p_batches) {
+        auto draw_batches = [&](const ArenaVector<BatchContext>& p_batches) {
             for (const auto& draw : p_batches) {
                 const bool has_bone = draw.bone_idx >= 0;
                 if (has_bone) {
@@ -29,6 +29,14 @@ enum class RenderState {
 };
 
 static struct {
+    // render data of a frame lives in the arena of its slot, which is only reset once the frame is no longer
+    // in flight
+    struct FrameData {
+        LinearArena arena{ LinearArena::DEFAULT_BLOCK_SIZE, memory::MEMORY_TAG_RENDER_DATA };
+        RenderData* renderData = nullptr;
+    };
+    std::array<FrameData, GraphicsManager::NUM_FRAMES_IN_FLIGHT> frames;
+    uint32_t frameIndex;
     RenderData* renderData;
     RenderState state;
     PathTracer pt;
@@ -46,11 +54,15 @@ void RegisterDvars() {
 }
 
 void BeginFrame() {
-    // @TODO: should be a better way
-    if (s_glob.renderData) {
-        delete s_glob.renderData;
-        s_glob.renderData = nullptr;
+    s_glob.frameIndex = (s_glob.frameIndex + 1) % GraphicsManager::NUM_FRAMES_IN_FLIGHT;
+    LinearArena& arena = s_glob.frames[s_glob.frameIndex].arena;
+    RenderData*& render_data = s_glob.frames[s_glob.frameIndex].renderData;
+    // the arena doesn't run destructors, some members still own memory elsewhere
+    if (render_data) {
+        render_data->~RenderData();
+        render_data = nullptr;
     }
+    arena.Reset();
 
     RenderOptions options = {
         .isOpengl = GraphicsManager::GetSingleton().GetBackend() == Backend::OPENGL,
@@ -66,7 +78,8 @@ void BeginFrame() {
     // @TODO: configure
     options.dynamicSky = true;
 
-    s_glob.renderData = new RenderData(options);
+    render_data = arena.New<RenderData>(options, arena);
+    s_glob.renderData = render_data;
     s_glob.renderData->bakeIbl = false;
     s_glob.state = RenderState::RECORDING;
 }
@@ -3,8 +3,8 @@
 
 namespace my::renderer {
 
-template<typename T>
-static GpuBufferDesc CreateDesc(const std::vector<T>& p_data) {
+template<typename T, typename ALLOCATOR>
+static GpuBufferDesc CreateDesc(const std::vector<T, ALLOCATOR>& p_data) {
     GpuBufferDesc desc{
         .elementSize = sizeof(T),
         .elementCount = static_cast<uint32_t>(p_data.size()),
@@ -7,7 +7,8 @@
 #include "engine/renderer/renderer.h"
 #include "engine/scene/scene_system.h"
 #include "engine/systems/ecs/component_manager.inl"
-#include "engine/systems/job_system/job_system.h"
+#include "engine/systems/job_system/parallel_for.h"
+#include "engine/systems/job_system/scratch_allocator.h"
 
 // @TODO: refactor
 #include "engine/renderer/graphics_dvars.h"
@@ -25,20 +26,25 @@ REGISTER_COMPONENT_LIST
 namespace my {
 
 using jobsystem::Context;
+using jobsystem::JobHandle;
 
-static constexpr uint32_t SMALL_SUBTASK_GROUP_SIZE = 64;
+// hierarchy levels up to this size are merged into a single job
+static constexpr uint32_t SMALL_LEVEL_SIZE = 64;
 
-#define JS_FORCE_PARALLEL_FOR(TYPE, CTX, INDEX, SUBCOUNT, BODY) \
-    CTX.Dispatch(                                               \
-        static_cast<uint32_t>(GetCount<TYPE>()),                \
-        SUBCOUNT,                                               \
-        [&](jobsystem::JobArgs args) { const uint32_t INDEX = args.jobIndex; do { BODY; } while(0); })
+// the body runs after the calling function returned, it must not capture locals by reference
+#define JS_FORCE_PARALLEL_FOR(TYPE, CTX, DEPENDENCY, INDEX, BODY) \
+    return jobsystem::ParallelFor(                                \
+        CTX,                                                      \
+        DEPENDENCY,                                               \
+        static_cast<uint32_t>(GetCount<TYPE>()),                  \
+        [this](const uint32_t INDEX) { do { BODY; } while(0); })
 
-#define JS_NO_PARALLEL_FOR(TYPE, CTX, INDEX, SUBCOUNT, BODY)    \
-    (void)(CTX);                                                \
+#define JS_NO_PARALLEL_FOR(TYPE, CTX, DEPENDENCY, INDEX, BODY)  \
+    CTX.Wait(DEPENDENCY);                                       \
     for (size_t INDEX = 0; INDEX < GetCount<TYPE>(); ++INDEX) { \
         BODY;                                                   \
-    }
+    }                                                           \
+    return JobHandle()
 
 #if 1
 #define JS_PARALLEL_FOR JS_FORCE_PARALLEL_FOR
@@ -46,51 +52,92 @@ static constexpr uint32_t SMALL_SUBTASK_GROUP_SIZE = 64;
 #define JS_PARALLEL_FOR JS_NO_PARALLEL_FOR
 #endif
 
-void Scene::Update(float p_time_step) {
-    HBN_PROFILE_EVENT();
+Scene::Scene(std::pmr::memory_resource* p_upstream) : IAsset(AssetType::SCENE),
+                                                      m_upstream(memory::MEMORY_TAG_ECS, p_upstream),
+                                                      m_memory(&m_upstream),
+                                                      m_componentLib(&m_memory) {
+    RegisterSystems();
+}
 
-    m_timestep = p_time_step;
-    m_dirtyFlags.store(0);
+// Access masks decide what runs in parallel, so a system has to list every component it touches. Between
+// conflicting systems the order here is the frame order.
+void Scene::RegisterSystems() {
+    auto dispatch = [this](JobHandle (Scene::*p_method)(Context&, const JobHandle&)) {
+        return [this, p_method](Context& p_context, const JobHandle& p_dependency) {
+            return (this->*p_method)(p_context, p_dependency);
+        };
+    };
 
-    Context ctx;
-    // animation
-    RunLightUpdateSystem(ctx);
-    RunAnimationUpdateSystem(ctx);
-    ctx.Wait();
+    m_systemGraph.Register({
+        .name = "animation",
+        .writes = GetComponentMask<AnimationComponent, TransformComponent>(),
+        .run = dispatch(&Scene::RunAnimationUpdateSystem),
+    });
+    m_systemGraph.Register({
+        .name = "light",
+        .reads = GetComponentMask<TransformComponent>(),
+        .writes = GetComponentMask<LightComponent>(),
+        .update = [this]() { RunLightUpdateSystem(); },
+    });
     // transform, update local matrix from position, rotation and scale
-    RunTransformationUpdateSystem(ctx);
-    ctx.Wait();
+    m_systemGraph.Register({
+        .name = "transform",
+        .writes = GetComponentMask<TransformComponent>(),
+        .run = dispatch(&Scene::RunTransformationUpdateSystem),
+    });
     // hierarchy, update world matrix based on hierarchy
-    RunHierarchyUpdateSystem(ctx);
-    ctx.Wait();
-    // mesh particles
-    RunMeshEmitterUpdateSystem(ctx);
-    // particle
-    RunParticleEmitterUpdateSystem(ctx);
-    // armature
-    RunArmatureUpdateSystem(ctx);
-    ctx.Wait();
-
+    m_systemGraph.Register({
+        .name = "hierarchy",
+        .reads = GetComponentMask<HierarchyComponent>(),
+        .writes = GetComponentMask<TransformComponent>(),
+        .run = dispatch(&Scene::RunHierarchyUpdateSystem),
+    });
+    m_systemGraph.Register({
+        .name = "armature",
+        .reads = GetComponentMask<TransformComponent>(),
+        .writes = GetComponentMask<ArmatureComponent>(),
+        .run = dispatch(&Scene::RunArmatureUpdateSystem),
+    });
+    m_systemGraph.Register({
+        .name = "mesh emitter",
+        .reads = GetComponentMask<TransformComponent>(),
+        .writes = GetComponentMask<MeshEmitterComponent>(),
+        .update = [this]() { RunMeshEmitterUpdateSystem(); },
+    });
+    m_systemGraph.Register({
+        .name = "particle emitter",
+        .writes = GetComponentMask<ParticleEmitterComponent>(),
+        .update = [this]() { RunParticleEmitterUpdateSystem(); },
+    });
     // update bounding box
-    RunObjectUpdateSystem(ctx);
+    m_systemGraph.Register({
+        .name = "object",
+        .reads = GetComponentMask<ObjectComponent, TransformComponent, MeshComponent>(),
+        .update = [this]() { RunObjectUpdateSystem(); },
+    });
+    m_systemGraph.Register({
+        .name = "camera",
+        .writes = GetComponentMask<PerspectiveCameraComponent>(),
+        .update = [this]() { RunCameraUpdateSystem(); },
+    });
+    m_systemGraph.Register({
+        .name = "voxel gi",
+        .reads = GetComponentMask<TransformComponent>(),
+        .writes = GetComponentMask<VoxelGiComponent>(),
+        .update = [this]() { RunVoxelGiUpdateSystem(); },
+    });
+}
 
-    // @TODO: refactor
-    for (auto [entity, camera] : m_PerspectiveCameraComponents) {
-        if (camera.Update()) {
-            m_dirtyFlags.fetch_or(SCENE_DIRTY_CAMERA);
-        }
-    }
+void Scene::Update(float p_time_step) {
+    HBN_PROFILE_EVENT();
 
-    for (auto [entity, voxel_gi] : m_VoxelGiComponents) {
-        auto transform = GetComponent<TransformComponent>(entity);
-        if (DEV_VERIFY(transform)) {
-            const auto& matrix = transform->GetWorldMatrix();
-            Vector3f center{ matrix[3].x, matrix[3].y, matrix[3].z };
-            Vector3f scale = transform->GetScale();
-            const float size = glm::max(scale.x, glm::max(scale.y, scale.z));
-            voxel_gi.region = AABB::FromCenterSize(center, Vector3f(size));
-        }
-    }
+    m_timestep = p_time_step;
+    m_dirtyFlags.store(0);
+
+    // systems that don't touch the same components run concurrently
+    Context ctx(jobsystem::JOB_PRIORITY_CRITICAL);
+    m_systemGraph.Run(ctx);
+    ctx.Wait();
 
     // @TODO: refactor
     if (DVAR_GET_BOOL(gfx_bvh_generate)) {
@@ -508,12 +555,26 @@ ecs::Entity Scene::CreateForceFieldEntity(const std::string& p_name, const Matri
 }
 
 ecs::Entity Scene::FindEntityByName(const char* p_name) {
-    for (auto [entity, name] : m_NameComponents) {
-        if (name.GetName() == p_name) {
-            return entity;
+    return FindEntityByName(StringId(p_name));
+}
+
+ecs::Entity Scene::FindEntityByName(StringId p_name) {
+    std::lock_guard lock(m_nameLookupLock);
+    const uint32_t version = m_NameComponents.GetVersion();
+    const uint32_t rename_count = NameComponent::GetRenameCount();
+    if (version != m_nameLookupVersion || rename_count != m_nameLookupRenameCount) {
+        m_nameLookup.clear();
+        m_nameLookup.reserve(m_NameComponents.GetCount());
+        // the first entity with the name wins, same as walking the components
+        for (auto [entity, name] : m_NameComponents) {
+            m_nameLookup.try_emplace(name.GetNameId(), entity);
         }
+        m_nameLookupVersion = version;
+        m_nameLookupRenameCount = rename_count;
     }
-    return ecs::Entity::INVALID;
+
+    auto it = m_nameLookup.find(p_name);
+    return it == m_nameLookup.end() ? ecs::Entity::INVALID : it->second;
 }
 
 void Scene::AttachChild(ecs::Entity p_child, ecs::Entity p_parent) {
@@ -546,14 +607,14 @@ void Scene::RemoveEntity(ecs::Entity p_entity) {
         if (shadow_handle != renderer::INVALID_POINT_SHADOW_HANDLE) {
             renderer::FreePointLightShadowMap(shadow_handle);
         }
-        m_LightComponents.Remove(p_entity);
     }
-    m_HierarchyComponents.Remove(p_entity);
-    m_TransformComponents.Remove(p_entity);
-    m_ObjectComponents.Remove(p_entity);
-    m_ParticleEmitterComponents.Remove(p_entity);
-    m_ForceFieldComponents.Remove(p_entity);
-    m_NameComponents.Remove(p_entity);
+
+    // the entity index is recycled, so no manager can keep a component of it around
+    for (auto& entry : m_componentLib.m_entries) {
+        entry.second.m_manager->Remove(p_entity);
+    }
+
+    ecs::Entity::Destroy(p_entity);
 }
 
 void Scene::UpdateAnimation(size_t p_index) {
@@ -659,36 +720,77 @@ void Scene::UpdateAnimation(size_t p_index) {
     }
 }
 
-void Scene::UpdateHierarchy(size_t p_index) {
-    ecs::Entity self_id = GetEntityByIndex<HierarchyComponent>(p_index);
-    TransformComponent* self_transform = GetComponent<TransformComponent>(self_id);
+void Scene::RebuildHierarchyOrder() {
+    HBN_PROFILE_EVENT();
 
-    if (!self_transform) {
-        return;
-    }
+    constexpr uint32_t INVALID = ecs::SparseSet::INVALID;
+    const auto& hierarchies = m_HierarchyComponents.m_componentArray;
+    const uint32_t count = static_cast<uint32_t>(hierarchies.size());
+
+    // a node only has a parent node if the parent is part of the hierarchy and has a transform,
+    // otherwise the chain stops there, the same way walking up the parents would
+    auto find_parent_node = [&](uint32_t p_index) {
+        const ecs::Entity parent = hierarchies[p_index].m_parentId;
+        if (m_TransformComponents.FindIndex(parent) == INVALID) {
+            return INVALID;
+        }
+        return m_HierarchyComponents.FindIndex(parent);
+    };
+
+    jobsystem::ScratchScope scratch;
+    LinearArena& arena = scratch.GetArena();
+
+    // resolve the depth of every node, each node is visited once
+    jobsystem::ScratchVector<uint32_t> depths(count, INVALID, arena);
+    jobsystem::ScratchVector<uint32_t> chain(arena);
+    chain.reserve(count);
+    uint32_t level_count = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t cursor = i;
+        while (depths[cursor] == INVALID) {
+            chain.push_back(cursor);
+            CRASH_COND_MSG(chain.size() > count, "cycle detected in hierarchy");
+            const uint32_t parent = find_parent_node(cursor);
+            if (parent == INVALID) {
+                break;
+            }
+            cursor = parent;
+        }
 
-    Matrix4x4f world_matrix = self_transform->GetLocalMatrix();
-    const HierarchyComponent* hierarchy = &GetComponentByIndex<HierarchyComponent>(p_index);
-    ecs::Entity parent = hierarchy->m_parentId;
+        uint32_t depth = depths[cursor] == INVALID ? 0 : depths[cursor] + 1;
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+            depths[*it] = depth++;
+        }
+        level_count = std::max(level_count, depth);
+        chain.clear();
+    }
 
-    while (parent.IsValid()) {
-        TransformComponent* parent_transform = GetComponent<TransformComponent>(parent);
-        if (DEV_VERIFY(parent_transform)) {
-            world_matrix = parent_transform->GetLocalMatrix() * world_matrix;
+    // counting sort by depth
+    jobsystem::ScratchVector<uint32_t> transform_indices(count, arena);
+    m_hierarchyLevels.assign(level_count + 1, 0);
+    for (uint32_t i = 0; i < count; ++i) {
+        transform_indices[i] = m_TransformComponents.FindIndex(m_HierarchyComponents.m_entityArray[i]);
+        if (transform_indices[i] != INVALID) {
+            ++m_hierarchyLevels[depths[i] + 1];
+        }
+    }
+    for (uint32_t level = 1; level <= level_count; ++level) {
+        m_hierarchyLevels[level] += m_hierarchyLevels[level - 1];
+    }
 
-            if ((hierarchy = GetComponent<HierarchyComponent>(parent)) != nullptr) {
-                parent = hierarchy->m_parentId;
-                DEV_ASSERT(parent.IsValid());
-            } else {
-                parent.MakeInvalid();
-            }
-        } else {
-            break;
+    jobsystem::ScratchVector<uint32_t> offsets(m_hierarchyLevels.begin(), m_hierarchyLevels.end() - 1, arena);
+    m_hierarchyNodes.resize(m_hierarchyLevels.back());
+    for (uint32_t i = 0; i < count; ++i) {
+        if (transform_indices[i] == INVALID) {
+            continue;
         }
+        HierarchyNode& node = m_hierarchyNodes[offsets[depths[i]]++];
+        node.transformIndex = transform_indices[i];
+        node.parentTransformIndex = m_TransformComponents.FindIndex(hierarchies[i].m_parentId);
     }
 
-    self_transform->SetWorldMatrix(world_matrix);
-    self_transform->SetDirty(false);
+    m_hierarchyVersion = m_HierarchyComponents.GetVersion();
+    m_hierarchyTransformVersion = m_TransformComponents.GetVersion();
 }
 
 void Scene::UpdateArmature(size_t p_index) {
@@ -730,7 +832,7 @@ void Scene::UpdateArmature(size_t p_index) {
 
 bool Scene::RayObjectIntersect(ecs::Entity p_object_id, Ray& p_ray) {
     ObjectComponent* object = GetComponent<ObjectComponent>(p_object_id);
-    MeshComponent* mesh = GetComponent<MeshComponent>(object->meshId);
+    MeshComponent* mesh = object ? GetComponent<MeshComponent>(object->meshId) : nullptr;
     TransformComponent* transform = GetComponent<TransformComponent>(p_object_id);
     DEV_ASSERT(mesh && transform);
 
@@ -738,93 +840,140 @@ bool Scene::RayObjectIntersect(ecs::Entity p_object_id, Ray& p_ray) {
         return false;
     }
 
+    if (!mesh->bvh) {
+        mesh->bvh = BvhAccel::Construct(mesh->indices, mesh->positions);
+    }
+
+    // the ray is a segment, its distance is a fraction of it and doesn't change in mesh space
     Matrix4x4f inversedModel = glm::inverse(transform->GetWorldMatrix());
     Ray inversedRay = p_ray.Inverse(inversedModel);
-    Ray inversedRayAABB = inversedRay;  // make a copy, we don't want dist to be modified by AABB
-    // Perform aabb test
-    if (!inversedRayAABB.Intersects(mesh->localBound)) {
-        return false;
-    }
 
     // @TODO: test submesh intersection
+    const bool hit = mesh->bvh->Intersects(inversedRay, [&](uint32_t p_triangle) {
+        const Vector3f& A = mesh->positions[mesh->indices[3 * p_triangle]];
+        const Vector3f& B = mesh->positions[mesh->indices[3 * p_triangle + 1]];
+        const Vector3f& C = mesh->positions[mesh->indices[3 * p_triangle + 2]];
+        return inversedRay.Intersects(A, B, C);
+    });
 
-    // Test every single triange
-    for (size_t i = 0; i < mesh->indices.size(); i += 3) {
-        const Vector3f& A = mesh->positions[mesh->indices[i]];
-        const Vector3f& B = mesh->positions[mesh->indices[i + 1]];
-        const Vector3f& C = mesh->positions[mesh->indices[i + 2]];
-#define CC(a) Vector3f(a.x, a.y, a.z)
-        if (inversedRay.Intersects(CC(A), CC(B), CC(C))) {
-#undef CC
-            p_ray.CopyDist(inversedRay);
-            return true;
-        }
+    if (hit) {
+        p_ray.CopyDist(inversedRay);
     }
-    return false;
+    return hit;
 }
 
 Scene::RayIntersectionResult Scene::Intersects(Ray& p_ray) {
+    HBN_PROFILE_EVENT();
+
     RayIntersectionResult result;
 
+    if (!m_objectBvh) {
+        m_objectBvh = BvhAccel::Construct(m_objectBounds);
+    }
+
     // @TODO: box collider
-    for (size_t object_idx = 0; object_idx < GetCount<ObjectComponent>(); ++object_idx) {
-        ecs::Entity entity = GetEntity<ObjectComponent>(object_idx);
-        if (RayObjectIntersect(entity, p_ray)) {
-            result.entity = entity;
+    m_objectBvh->Intersects(p_ray, [&](uint32_t p_index) {
+        const ecs::Entity entity = m_objectBoundEntities[p_index];
+        // the object could have been removed since the last update
+        if (!Contains<ObjectComponent>(entity) || !RayObjectIntersect(entity, p_ray)) {
+            return false;
         }
-    }
+
+        result.entity = entity;
+        return true;
+    });
 
     return result;
 }
 
-void Scene::RunLightUpdateSystem(Context& p_context) {
+void Scene::RunLightUpdateSystem() {
     HBN_PROFILE_EVENT();
-    unused(p_context);
 
-    for (auto [id, light] : m_LightComponents) {
-        const TransformComponent* transform = GetComponent<TransformComponent>(id);
-        if (DEV_VERIFY(transform)) {
-            UpdateLight(m_timestep, *transform, light);
-        }
+    for (auto [id, light, transform] : View<LightComponent, TransformComponent>()) {
+        UpdateLight(m_timestep, transform, light);
     }
 }
 
-void Scene::RunTransformationUpdateSystem(Context& p_context) {
+JobHandle Scene::RunTransformationUpdateSystem(Context& p_context, const JobHandle& p_dependency) {
     HBN_PROFILE_EVENT();
-    JS_PARALLEL_FOR(TransformComponent, p_context, index, SMALL_SUBTASK_GROUP_SIZE, {
+    JS_PARALLEL_FOR(TransformComponent, p_context, p_dependency, index, {
         if (GetComponentByIndex<TransformComponent>(index).UpdateTransform()) {
             m_dirtyFlags.fetch_or(SCENE_DIRTY_WORLD);
         }
     });
 }
 
-void Scene::RunAnimationUpdateSystem(Context& p_context) {
+JobHandle Scene::RunAnimationUpdateSystem(Context& p_context, const JobHandle& p_dependency) {
     HBN_PROFILE_EVENT();
-    JS_PARALLEL_FOR(AnimationComponent, p_context, index, 1, UpdateAnimation(index));
+    JS_PARALLEL_FOR(AnimationComponent, p_context, p_dependency, index, UpdateAnimation(index));
 }
 
-void Scene::RunArmatureUpdateSystem(Context& p_context) {
+JobHandle Scene::RunArmatureUpdateSystem(Context& p_context, const JobHandle& p_dependency) {
     HBN_PROFILE_EVENT();
-    JS_PARALLEL_FOR(ArmatureComponent, p_context, index, 1, UpdateArmature(index));
+    JS_PARALLEL_FOR(ArmatureComponent, p_context, p_dependency, index, UpdateArmature(index));
 }
 
-void Scene::RunHierarchyUpdateSystem(Context& p_context) {
+JobHandle Scene::RunHierarchyUpdateSystem(Context& p_context, const JobHandle& p_dependency) {
     HBN_PROFILE_EVENT();
-    JS_PARALLEL_FOR(HierarchyComponent, p_context, index, SMALL_SUBTASK_GROUP_SIZE, UpdateHierarchy(index));
+
+    // only reads the entity arrays, so it's fine to rebuild while the transforms are being updated
+    if (m_hierarchyVersion != m_HierarchyComponents.GetVersion() ||
+        m_hierarchyTransformVersion != m_TransformComponents.GetVersion()) {
+        RebuildHierarchyOrder();
+    }
+
+    auto update_node = [this](uint32_t p_index) {
+        auto& transforms = m_TransformComponents.m_componentArray;
+        const HierarchyNode& node = m_hierarchyNodes[p_index];
+        TransformComponent& transform = transforms[node.transformIndex];
+        Matrix4x4f world_matrix = transform.GetLocalMatrix();
+        if (node.parentTransformIndex != ecs::SparseSet::INVALID) {
+            world_matrix = transforms[node.parentTransformIndex].GetWorldMatrix() * world_matrix;
+        }
+        transform.SetWorldMatrix(world_matrix);
+        transform.SetDirty(false);
+    };
+
+    // A node only reads the world matrix of its parent, so a whole level can run in parallel once the
+    // level above it is done. Each level is a continuation of the previous one, and runs of small levels
+    // (deep chains have lots of tiny levels) are merged into a single job.
+    JobHandle handle = p_dependency;
+    const size_t level_count = m_hierarchyLevels.empty() ? 0 : m_hierarchyLevels.size() - 1;
+    for (size_t level = 0; level < level_count;) {
+        const uint32_t begin = m_hierarchyLevels[level];
+        uint32_t end = m_hierarchyLevels[level + 1];
+        ++level;
+
+        if (end - begin > SMALL_LEVEL_SIZE) {
+            handle = jobsystem::ParallelFor(p_context, handle, end - begin, [update_node, begin](uint32_t p_index) {
+                update_node(begin + p_index);
+            });
+            continue;
+        }
+
+        for (; level < level_count && m_hierarchyLevels[level + 1] - m_hierarchyLevels[level] <= SMALL_LEVEL_SIZE; ++level) {
+            end = m_hierarchyLevels[level + 1];
+        }
+        handle = p_context.Then(handle, 1, 1, [update_node, begin, end](jobsystem::JobArgs) {
+            for (uint32_t i = begin; i < end; ++i) {
+                update_node(i);
+            }
+        });
+    }
+
+    return handle;
 }
 
-void Scene::RunObjectUpdateSystem(jobsystem::Context& p_context) {
+void Scene::RunObjectUpdateSystem() {
     HBN_PROFILE_EVENT();
-    unused(p_context);
 
     m_bound.MakeInvalid();
 
-    for (auto [entity, obj] : m_ObjectComponents) {
-        if (!Contains<TransformComponent>(entity)) {
-            continue;
-        }
+    // only throw away the ray query structure if something moved or the set of objects changed
+    bool changed = m_dirtyFlags.load() & SCENE_DIRTY_WORLD;
+    size_t count = 0;
 
-        const TransformComponent& transform = *GetComponent<TransformComponent>(entity);
+    for (auto [entity, obj, transform] : View<ObjectComponent, TransformComponent>()) {
         DEV_ASSERT(Contains<MeshComponent>(obj.meshId));
         const MeshComponent& mesh = *GetComponent<MeshComponent>(obj.meshId);
 
@@ -832,28 +981,63 @@ void Scene::RunObjectUpdateSystem(jobsystem::Context& p_context) {
         AABB aabb = mesh.localBound;
         aabb.ApplyMatrix(M);
         m_bound.UnionBox(aabb);
+
+        if (count < m_objectBounds.size()) {
+            changed = changed || m_objectBoundEntities[count] != entity;
+            m_objectBounds[count] = aabb;
+            m_objectBoundEntities[count] = entity;
+        } else {
+            changed = true;
+            m_objectBounds.emplace_back(aabb);
+            m_objectBoundEntities.emplace_back(entity);
+        }
+        ++count;
+    }
+
+    if (changed || count != m_objectBounds.size()) {
+        m_objectBounds.resize(count);
+        m_objectBoundEntities.resize(count);
+        m_objectBvh.reset();
     }
 }
 
-void Scene::RunParticleEmitterUpdateSystem(jobsystem::Context& p_context) {
+void Scene::RunParticleEmitterUpdateSystem() {
     HBN_PROFILE_EVENT();
-    unused(p_context);
 
     for (auto [entity, emitter] : m_ParticleEmitterComponents) {
         emitter.aliveBufferIndex = 1 - emitter.aliveBufferIndex;
     }
 }
 
-void Scene::RunMeshEmitterUpdateSystem(jobsystem::Context& p_context) {
+void Scene::RunMeshEmitterUpdateSystem() {
     HBN_PROFILE_EVENT();
 
-    unused(p_context);
-    for (auto [id, emitter] : m_MeshEmitterComponents) {
-        const TransformComponent* transform = GetComponent<TransformComponent>(id);
-        if (DEV_VERIFY(transform)) {
-            UpdateMeshEmitter(m_timestep, *transform, emitter);
+    for (auto [id, emitter, transform] : View<MeshEmitterComponent, TransformComponent>()) {
+        UpdateMeshEmitter(m_timestep, transform, emitter);
+    }
+}
+
+void Scene::RunCameraUpdateSystem() {
+    HBN_PROFILE_EVENT();
+
+    // @TODO: refactor
+    for (auto [entity, camera] : m_PerspectiveCameraComponents) {
+        if (camera.Update()) {
+            m_dirtyFlags.fetch_or(SCENE_DIRTY_CAMERA);
         }
     }
 }
 
+void Scene::RunVoxelGiUpdateSystem() {
+    HBN_PROFILE_EVENT();
+
+    for (auto [entity, voxel_gi, transform] : View<VoxelGiComponent, TransformComponent>()) {
+        const auto& matrix = transform.GetWorldMatrix();
+        Vector3f center{ matrix[3].x, matrix[3].y, matrix[3].z };
+        Vector3f scale = transform.GetScale();
+        const float size = glm::max(scale.x, glm::max(scale.y, scale.z));
+        voxel_gi.region = AABB::FromCenterSize(center, Vector3f(size));
+    }
+}
+
 }  // namespace my
@@ -1,17 +1,15 @@
 #pragma once
 #include "engine/assets/asset.h"
 #include "engine/core/base/noncopyable.h"
+#include "engine/core/debugger/memory_tracker.h"
 #include "engine/math/ray.h"
 #include "engine/scene/scene_component.h"
 #include "engine/systems/ecs/component_manager.h"
+#include "engine/systems/ecs/system_graph.h"
 #include "engine/systems/ecs/view.h"
 
 struct lua_State;
 
-namespace my::jobsystem {
-class Context;
-}
-
 namespace my {
 
 #define REGISTER_COMPONENT_LIST                                                            \
@@ -35,6 +33,14 @@ namespace my {
     REGISTER_COMPONENT(VoxelGiComponent, "World::VoxelGiComponent", 0)                     \
     REGISTER_COMPONENT(EnvironmentComponent, "World::EnvironmentComponent", 0)
 
+enum SceneComponentId : uint32_t {
+#define REGISTER_COMPONENT(T, ...) SCENE_COMPONENT_ID_##T,
+    REGISTER_COMPONENT_LIST
+#undef REGISTER_COMPONENT
+    SCENE_COMPONENT_ID_COUNT,
+};
+static_assert(SCENE_COMPONENT_ID_COUNT <= sizeof(ecs::ComponentMask) * 8);
+
 // @TODO: refactor
 struct PhysicsWorldContext;
 
@@ -54,12 +60,19 @@ enum SceneDirtyFlags : uint32_t {
 DEFINE_ENUM_BITWISE_OPERATIONS(SceneDirtyFlags);
 
 class Scene : public NonCopyable, public IAsset {
+    // All the component storage of the scene is pooled here and released in large chunks with the scene.
+    // Synchronized, systems running concurrently may grow different component arrays.
+    memory::TaggedMemoryResource m_upstream;
+    std::pmr::synchronized_pool_resource m_memory;
     ecs::ComponentLibrary m_componentLib;
 
 public:
     static constexpr const char* EXTENSION = ".scene";
 
-    Scene() : IAsset(AssetType::SCENE) {}
+    // p_upstream provides the chunks of the pool, e.g. an arena or huge pages reserved for the scene
+    explicit Scene(std::pmr::memory_resource* p_upstream = std::pmr::get_default_resource());
+
+    std::pmr::memory_resource* GetMemoryResource() { return &m_memory; }
 
 public:
     template<Serializable T>
@@ -74,26 +87,51 @@ public:
     ecs::Entity GetEntity(size_t) const { return ecs::Entity::INVALID; }
     template<Serializable T>
     T& Create(const ecs::Entity&) { return *(T*)(nullptr); }
+    template<Serializable T>
+    static constexpr ecs::ComponentMask GetComponentBit() {
+        // a zero bit would let the system run concurrently with the writers of T
+        static_assert(sizeof(T) == 0, "component is not registered in the scene");
+        return 0;
+    }
 
     template<Serializable T>
     inline T& GetComponentByIndex(size_t) { return *(T*)0; }
     template<Serializable T>
     inline ecs::Entity GetEntityByIndex(size_t) { return ecs::Entity::INVALID; }
 
+    // only the registered components have a manager, see REGISTER_COMPONENT
+    template<Serializable T>
+    inline ecs::ComponentManager<T>& GetComponentManager() {
+        static_assert(sizeof(T) == 0, "component is not registered in the scene");
+        std::unreachable();
+    }
+    template<Serializable T>
+    inline const ecs::ComponentManager<T>& GetComponentManager() const {
+        static_assert(sizeof(T) == 0, "component is not registered in the scene");
+        std::unreachable();
+    }
+
     template<typename T>
     inline ecs::View<T> View() {
         static_assert(0, "this code should never instantiate");
-        struct Dummy {};
-        ecs::ComponentManager<Dummy> dummyManager;
-        return ecs::View(dummyManager);
+        return ecs::View<T>(GetComponentManager<T>());
     }
 
     template<typename T>
     inline const ecs::View<T> View() const {
         static_assert(0, "this code should never instantiate");
-        struct Dummy {};
-        ecs::ComponentManager<Dummy> dummyManager;
-        return ecs::View(dummyManager);
+        return ecs::View<T>(GetComponentManager<T>());
+    }
+
+    // entities that have all of the components, e.g. View<ObjectComponent, TransformComponent>()
+    template<Serializable T1, Serializable T2, Serializable... Ts>
+    inline ecs::View<T1, T2, Ts...> View() {
+        return ecs::View<T1, T2, Ts...>(GetComponentManager<T1>(), GetComponentManager<T2>(), GetComponentManager<Ts>()...);
+    }
+
+    template<Serializable T1, Serializable T2, Serializable... Ts>
+    inline const ecs::View<T1, T2, Ts...> View() const {
+        return ecs::View<T1, T2, Ts...>(GetComponentManager<T1>(), GetComponentManager<T2>(), GetComponentManager<Ts>()...);
     }
 
 #pragma region WORLD_COMPONENTS_REGISTRY
@@ -118,7 +156,13 @@ public:
     template<>                                                                                                     \
     inline ecs::View<T> View() { return ecs::View<T>(m_##T##s); }                                                  \
     template<>                                                                                                     \
-    inline const ecs::View<T> View() const { return ecs::View<T>(m_##T##s); }
+    inline const ecs::View<T> View() const { return ecs::View<T>(m_##T##s); }                                      \
+    template<>                                                                                                     \
+    inline ecs::ComponentManager<T>& GetComponentManager<T>() { return m_##T##s; }                                 \
+    template<>                                                                                                     \
+    inline const ecs::ComponentManager<T>& GetComponentManager<T>() const { return m_##T##s; }                     \
+    template<>                                                                                                     \
+    constexpr ecs::ComponentMask GetComponentBit<T>() { return 1ull << SCENE_COMPONENT_ID_##T; }
 
 #pragma endregion WORLD_COMPONENTS_REGISTRY
 
@@ -126,8 +170,16 @@ public:
 #undef REGISTER_COMPONENT
 
 public:
+    // access mask of a system, e.g. GetComponentMask<TransformComponent, LightComponent>()
+    template<Serializable... Ts>
+    static constexpr ecs::ComponentMask GetComponentMask() { return (GetComponentBit<Ts>() | ... | 0ull); }
+
     void Update(float p_delta_time);
 
+    // Systems that run every Update(). The built-in ones are registered on construction, plugins can add
+    // their own with the components they access, they run concurrently with the systems they don't conflict with.
+    ecs::SystemGraph& GetSystemGraph() { return m_systemGraph; }
+
     void Copy(Scene& p_other);
 
     void Merge(Scene& p_other);
@@ -237,6 +289,9 @@ public:
 
     ecs::Entity FindEntityByName(const char* p_name);
 
+    // hashed lookup, rebuilt after entities were named, renamed or removed
+    ecs::Entity FindEntityByName(StringId p_name);
+
     void AttachChild(ecs::Entity p_entity, ecs::Entity p_parent);
 
     void AttachChild(ecs::Entity p_entity) { AttachChild(p_entity, m_root); }
@@ -266,18 +321,51 @@ public:
     SceneDirtyFlags GetDirtyFlags() const { return static_cast<SceneDirtyFlags>(m_dirtyFlags.load()); }
 
 private:
-    void UpdateHierarchy(size_t p_index);
+    void RebuildHierarchyOrder();
     void UpdateAnimation(size_t p_index);
     void UpdateArmature(size_t p_index);
 
-    void RunLightUpdateSystem(jobsystem::Context& p_context);
-    void RunTransformationUpdateSystem(jobsystem::Context& p_context);
-    void RunHierarchyUpdateSystem(jobsystem::Context& p_context);
-    void RunAnimationUpdateSystem(jobsystem::Context& p_context);
-    void RunArmatureUpdateSystem(jobsystem::Context& p_context);
-    void RunObjectUpdateSystem(jobsystem::Context& p_context);
-    void RunParticleEmitterUpdateSystem(jobsystem::Context& p_context);
-    void RunMeshEmitterUpdateSystem(jobsystem::Context& p_context);
+    void RegisterSystems();
+
+    // the parallel systems start once p_dependency is done, and return a handle to their jobs
+    jobsystem::JobHandle RunTransformationUpdateSystem(jobsystem::Context& p_context, const jobsystem::JobHandle& p_dependency);
+    jobsystem::JobHandle RunHierarchyUpdateSystem(jobsystem::Context& p_context, const jobsystem::JobHandle& p_dependency);
+    jobsystem::JobHandle RunAnimationUpdateSystem(jobsystem::Context& p_context, const jobsystem::JobHandle& p_dependency);
+    jobsystem::JobHandle RunArmatureUpdateSystem(jobsystem::Context& p_context, const jobsystem::JobHandle& p_dependency);
+    // the serial ones run as a single job
+    void RunLightUpdateSystem();
+    void RunObjectUpdateSystem();
+    void RunParticleEmitterUpdateSystem();
+    void RunMeshEmitterUpdateSystem();
+    void RunCameraUpdateSystem();
+    void RunVoxelGiUpdateSystem();
+
+    ecs::SystemGraph m_systemGraph;
+
+    // Flattened hierarchy, sorted by depth so parents always come before their children.
+    // Indices are dense indices of the transform manager, the order is rebuilt when the hierarchy
+    // or transform managers change structurally.
+    struct HierarchyNode {
+        uint32_t transformIndex;
+        uint32_t parentTransformIndex;
+    };
+    std::vector<HierarchyNode> m_hierarchyNodes;
+    // nodes of depth d are in range [m_hierarchyLevels[d], m_hierarchyLevels[d + 1])
+    std::vector<uint32_t> m_hierarchyLevels;
+    uint32_t m_hierarchyVersion = ~0u;
+    uint32_t m_hierarchyTransformVersion = ~0u;
+
+    // world space bounds of the objects, rebuilt every update. The ray query structure is built
+    // from them lazily, only when a query comes in after the world changed.
+    std::vector<AABB> m_objectBounds;
+    std::vector<ecs::Entity> m_objectBoundEntities;
+    std::shared_ptr<BvhAccel> m_objectBvh;
+
+    // name -> entity, rebuilt by FindEntityByName() when the name manager changed or a name was set
+    std::mutex m_nameLookupLock;
+    std::unordered_map<StringId, ecs::Entity> m_nameLookup;
+    uint32_t m_nameLookupVersion = ~0u;
+    uint32_t m_nameLookupRenameCount = ~0u;
 
     // @TODO: refactor
     AABB m_bound;
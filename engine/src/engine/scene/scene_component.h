@@ -1,4 +1,5 @@
 #pragma once
+#include "engine/core/string/string_id.h"
 #include "engine/math/aabb.h"
 #include "engine/math/angle.h"
 #include "engine/math/geomath.h"
@@ -43,21 +44,30 @@ class NameComponent {
 public:
     NameComponent() = default;
 
-    NameComponent(const char* p_name) { m_name = p_name; }
+    NameComponent(const char* p_name) { SetName(p_name); }
 
-    void SetName(const char* p_name) { m_name = p_name; }
-    void SetName(const std::string& p_name) { m_name = p_name; }
+    void SetName(std::string_view p_name) {
+        m_name = p_name;
+        m_nameId = StringId::Intern(p_name);
+        s_renameCount.fetch_add(1, std::memory_order_relaxed);
+    }
 
     const std::string& GetName() const { return m_name; }
-    std::string& GetNameRef() { return m_name; }
+    StringId GetNameId() const { return m_nameId; }
+
+    // bumped by every SetName(), lets name lookups tell when to rebuild
+    static uint32_t GetRenameCount() { return s_renameCount.load(std::memory_order_relaxed); }
 
     void Serialize(Archive& p_archive, uint32_t p_version);
-    void OnDeserialized() {}
+    void OnDeserialized() { SetName(std::string(m_name)); }
 
     static void RegisterClass();
 
 private:
     std::string m_name;
+    StringId m_nameId;
+
+    inline static std::atomic_uint32_t s_renameCount;
 };
 #pragma endregion NAME_COMPONENT
 
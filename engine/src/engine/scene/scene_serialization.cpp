@@ -7,6 +7,7 @@
 #include "engine/core/io/file_access.h"
 #include "engine/core/string/string_utils.h"
 #include "engine/scene/scene.h"
+#include "engine/systems/job_system/job_system.h"
 #include "engine/systems/serialization/serialization.h"
 
 namespace my {
@@ -34,12 +35,26 @@ namespace my {
 // version 17: remove armature.flags
 // version 18: change RigidBodyComponent
 // version 19: serialize scene.m_physicsMode
+// version 20: one chunk per component manager, located through a table of contents
 #pragma endregion VERSION_HISTORY
-static constexpr uint32_t LATEST_SCENE_VERSION = 19;
+static constexpr uint32_t LATEST_SCENE_VERSION = 20;
 static constexpr char SCENE_MAGIC[] = "xBScene";
 static constexpr char SCENE_GUARD_MESSAGE[] = "Should see this message";
 static constexpr uint64_t HAS_NEXT_FLAG = 6368519827137030510;
 
+// Layout since version 20:
+//   header (magic, version, seed, root, physics mode, guard message)
+//   chunks, each one is a component manager written by IComponentManager::Serialize()
+//   table of contents: chunk count, then name, offset and size of every chunk
+//   offset of the table of contents, always the last 8 bytes of the file
+// Chunks don't depend on each other, so they are decoded concurrently, and can be skipped.
+struct SceneChunk {
+    std::string name;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+    ecs::IComponentManager* manager = nullptr;
+};
+
 Result<void> SaveSceneBinary(const std::string& p_path, Scene& p_scene) {
     Archive archive;
     if (auto res = archive.OpenWrite(p_path); !res) {
@@ -54,20 +69,152 @@ Result<void> SaveSceneBinary(const std::string& p_path, Scene& p_scene) {
 
     archive << SCENE_GUARD_MESSAGE;
 
+    auto& file = archive.GetFileAccess();
+    std::vector<SceneChunk> chunks;
     for (const auto& it : p_scene.GetLibraryEntries()) {
         if (it.second.m_manager->GetCount()) {
-            archive << HAS_NEXT_FLAG;
-            archive << it.first;  // write name
+            SceneChunk chunk;
+            chunk.name = it.second.m_name;
+            chunk.offset = static_cast<uint64_t>(file->Tell());
             it.second.m_manager->Serialize(archive, LATEST_SCENE_VERSION);
+            chunk.size = static_cast<uint64_t>(file->Tell()) - chunk.offset;
+            chunks.emplace_back(std::move(chunk));
         }
     }
-    archive << uint64_t(0);
+
+    const uint64_t toc_offset = static_cast<uint64_t>(file->Tell());
+    archive << static_cast<uint32_t>(chunks.size());
+    for (const SceneChunk& chunk : chunks) {
+        archive << chunk.name;
+        archive << chunk.offset;
+        archive << chunk.size;
+    }
+
+    if (!archive.Write(toc_offset)) {
+        return HBN_ERROR(ErrorCode::ERR_FILE_CANT_WRITE, "failed to save file '{}'", p_path);
+    }
     return Result<void>();
 }
 
-Result<void> LoadSceneBinary(const std::string& p_path, Scene& p_scene) {
+static bool IsSkipped(std::span<const std::string_view> p_skipped_components, std::string_view p_name) {
+    return std::find(p_skipped_components.begin(), p_skipped_components.end(), p_name) != p_skipped_components.end();
+}
+
+static Result<void> LoadSceneComponents(Archive& p_archive,
+                                        Scene& p_scene,
+                                        uint32_t p_version,
+                                        std::span<const std::string_view> p_skipped_components) {
+    for (;;) {
+        uint64_t has_next = 0;
+        p_archive >> has_next;
+        if (has_next != HAS_NEXT_FLAG) {
+            return Result<void>();
+        }
+
+        std::string key;
+        p_archive >> key;
+
+        SCENE_DBG_LOG("Loading Component {}", key);
+
+        auto it = p_scene.GetLibraryEntries().find(StringId(key));
+        if (it == p_scene.GetLibraryEntries().end()) {
+            return HBN_ERROR(ErrorCode::ERR_FILE_CORRUPT, "entry '{}' not found", key);
+        }
+        if (!it->second.m_manager->Serialize(p_archive, p_version)) {
+            return HBN_ERROR(ErrorCode::ERR_FILE_CORRUPT, "failed to serialize '{}'", key);
+        }
+        // the stream has no sizes, so a skipped component is still decoded to get past it
+        if (IsSkipped(p_skipped_components, key)) {
+            SCENE_DBG_LOG("Skipping Component {}", key);
+            it->second.m_manager->Clear();
+        }
+    }
+}
+
+static Result<void> LoadSceneChunks(Archive& p_archive,
+                                    Scene& p_scene,
+                                    uint32_t p_version,
+                                    std::span<const std::string_view> p_skipped_components) {
+    auto& file = p_archive.GetFileAccess();
+    const uint64_t chunks_begin = static_cast<uint64_t>(file->Tell());
+    const uint64_t length = file->GetLength();
+
+    uint64_t toc_offset = 0;
+    if (length < chunks_begin + sizeof(toc_offset) ||
+        file->Seek(static_cast<long>(length - sizeof(toc_offset))) != 0 ||
+        !p_archive.Read(toc_offset) ||
+        toc_offset < chunks_begin ||
+        toc_offset > length - sizeof(toc_offset) ||
+        file->Seek(static_cast<long>(toc_offset)) != 0) {
+        return HBN_ERROR(ErrorCode::ERR_FILE_CORRUPT, "failed to locate table of contents");
+    }
+
+    uint32_t chunk_count = 0;
+    if (!p_archive.Read(chunk_count)) {
+        return HBN_ERROR(ErrorCode::ERR_FILE_CORRUPT, "failed to read table of contents");
+    }
+
+    std::vector<SceneChunk> chunks;
+    for (uint32_t i = 0; i < chunk_count; ++i) {
+        SceneChunk chunk;
+        if (!p_archive.Read(chunk.name) || !p_archive.Read(chunk.offset) || !p_archive.Read(chunk.size)) {
+            return HBN_ERROR(ErrorCode::ERR_FILE_CORRUPT, "failed to read table of contents");
+        }
+        if (chunk.offset < chunks_begin || chunk.offset > toc_offset || chunk.size > toc_offset - chunk.offset) {
+            return HBN_ERROR(ErrorCode::ERR_FILE_CORRUPT, "chunk '{}' is out of range", chunk.name);
+        }
+
+        if (IsSkipped(p_skipped_components, chunk.name)) {
+            SCENE_DBG_LOG("Skipping Component {}", chunk.name);
+            continue;
+        }
+
+        auto it = p_scene.GetLibraryEntries().find(StringId(chunk.name));
+        if (it == p_scene.GetLibraryEntries().end()) {
+            return HBN_ERROR(ErrorCode::ERR_FILE_CORRUPT, "entry '{}' not found", chunk.name);
+        }
+
+        chunk.manager = it->second.m_manager.get();
+        // two chunks can't decode into the same manager
+        for (const SceneChunk& other : chunks) {
+            if (other.manager == chunk.manager) {
+                return HBN_ERROR(ErrorCode::ERR_FILE_CORRUPT, "duplicated entry '{}'", chunk.name);
+            }
+        }
+        chunks.emplace_back(std::move(chunk));
+    }
+
+    const uint32_t job_count = static_cast<uint32_t>(chunks.size());
+    std::vector<ErrorRef> errors(job_count);
+
+    jobsystem::Context ctx;
+    ctx.Dispatch(job_count, 1, [&](jobsystem::JobArgs p_args) {
+        const SceneChunk& chunk = chunks[p_args.jobIndex];
+        SCENE_DBG_LOG("Loading Component {}", chunk.name);
+
+        // every chunk is read through its own view of the mapping, bounded by the chunk size
+        Archive chunk_archive;
+        if (auto res = chunk_archive.OpenReadMapped(p_archive, chunk.offset, chunk.size); !res) {
+            errors[p_args.jobIndex] = res.error();
+            return;
+        }
+        if (!chunk.manager->Serialize(chunk_archive, p_version)) {
+            errors[p_args.jobIndex] = HBN_ERROR(ErrorCode::ERR_FILE_CORRUPT, "failed to serialize '{}'", chunk.name).error();
+        }
+    });
+    ctx.Wait();
+
+    for (ErrorRef& error : errors) {
+        if (error) {
+            return HBN_ERROR(error);
+        }
+    }
+    return Result<void>();
+}
+
+Result<void> LoadSceneBinary(const std::string& p_path, Scene& p_scene, std::span<const std::string_view> p_skipped_components) {
     Archive archive;
-    if (auto res = archive.OpenRead(p_path); !res) {
+    if (auto res = archive.OpenReadMapped(p_path); !res) {
         return HBN_ERROR(res.error());
     }
 
@@ -103,26 +250,14 @@ Result<void> LoadSceneBinary(const std::string& p_path, Scene& p_scene) {
         return HBN_ERROR(ErrorCode::ERR_FILE_CORRUPT);
     }
 
-    for (;;) {
-        uint64_t has_next = 0;
-        archive >> has_next;
-        if (has_next != HAS_NEXT_FLAG) {
-            return Result<void>();
-        }
-
-        std::string key;
-        archive >> key;
-
-        SCENE_DBG_LOG("Loading Component {}", key);
-
-        auto it = p_scene.GetLibraryEntries().find(key);
-        if (it == p_scene.GetLibraryEntries().end()) {
-            return HBN_ERROR(ErrorCode::ERR_FILE_CORRUPT, "entry '{}' not found", key);
-        }
-        if (!it->second.m_manager->Serialize(archive, version)) {
-            return HBN_ERROR(ErrorCode::ERR_FILE_CORRUPT, "failed to serialize '{}'", key);
+    if (version < 20) {
+        if (!p_skipped_components.empty()) {
+            LOG_WARN("scene '{}' (version {}) has no table of contents, skipped components are decoded and then dropped", p_path, version);
         }
+        return LoadSceneComponents(archive, p_scene, version, p_skipped_components);
     }
+
+    return LoadSceneChunks(archive, p_scene, version, p_skipped_components);
 }
 
 template<Serializable T>
@@ -5,7 +5,10 @@ namespace my {
 class Scene;
 
 [[nodiscard]] Result<void> SaveSceneBinary(const std::string& p_path, Scene& p_scene);
-[[nodiscard]] Result<void> LoadSceneBinary(const std::string& p_path, Scene& p_scene);
+// p_skipped_components are names of component managers to leave empty, e.g. "World::LuaScriptComponent"
+[[nodiscard]] Result<void> LoadSceneBinary(const std::string& p_path,
+                                           Scene& p_scene,
+                                           std::span<const std::string_view> p_skipped_components = {});
 
 [[nodiscard]] Result<void> SaveSceneText(const std::string& p_path, const Scene& p_scene);
 [[nodiscard]] Result<void> LoadSceneText(const std::string& p_path, Scene& p_scene);
@@ -4,6 +4,7 @@
 #include "engine/core/framework/graphics_manager.h"
 #include "engine/math/matrix_transform.h"
 #include "engine/renderer/renderer.h"
+#include "engine/systems/job_system/scratch_allocator.h"
 
 namespace my {
 
@@ -55,7 +56,8 @@ void UpdateMeshEmitter(float p_timestep,
     }
 
     // 3. recycle
-    std::vector<MeshEmitterComponent::Index> tmp;
+    jobsystem::ScratchScope scratch;
+    jobsystem::ScratchVector<MeshEmitterComponent::Index> tmp(scratch.GetArena());
     tmp.reserve(p_emitter.aliveList.size());
     const bool recycle = p_emitter.IsRecycle();
     for (int i = (int)p_emitter.aliveList.size() - 1; i >= 0; --i) {
@@ -70,7 +72,7 @@ void UpdateMeshEmitter(float p_timestep,
             tmp.push_back(index);
         }
     }
-    p_emitter.aliveList = std::move(tmp);
+    p_emitter.aliveList.assign(tmp.begin(), tmp.end());
 }
 
 void UpdateLight(float p_timestep,
@@ -1,5 +1,10 @@
 #pragma once
+#include <memory_resource>
+
+#include "engine/core/string/string_id.h"
+
 #include "entity.h"
+#include "sparse_set.h"
 
 namespace YAML {
 class Node;
@@ -21,9 +26,11 @@ concept Serializable = requires(T& t, Archive& p_archive, uint32_t p_version) {
 
 namespace my::ecs {
 
-template<Serializable T>
+template<Serializable... Ts>
 class View;
 
+using EntityArray = std::pmr::vector<Entity>;
+
 // @TODO: remove this iterator, use view iterator instead
 #define COMPONENT_MANAGER_ITERATOR_COMMON                                              \
 public:                                                                                \
@@ -54,7 +61,7 @@ class ComponentManagerIterator {
     using self_type = ComponentManagerIterator<T>;
 
 public:
-    ComponentManagerIterator(std::vector<Entity>& p_entity_array, std::vector<T>& p_component_array, size_t p_index)
+    ComponentManagerIterator(std::span<Entity> p_entity_array, std::span<T> p_component_array, size_t p_index)
         : m_entityArray(p_entity_array),
           m_componentArray(p_component_array),
           m_index(p_index) {}
@@ -66,8 +73,8 @@ public:
     }
 
 private:
-    std::vector<Entity>& m_entityArray;
-    std::vector<T>& m_componentArray;
+    std::span<Entity> m_entityArray;
+    std::span<T> m_componentArray;
 
     size_t m_index;
 };
@@ -77,7 +84,7 @@ class ComponentManagerConstIterator {
     using self_type = ComponentManagerConstIterator<T>;
 
 public:
-    ComponentManagerConstIterator(const std::vector<Entity>& p_entity_array, const std::vector<T>& p_component_array, size_t p_index)
+    ComponentManagerConstIterator(std::span<const Entity> p_entity_array, std::span<const T> p_component_array, size_t p_index)
         : m_entityArray(p_entity_array),
           m_componentArray(p_component_array),
           m_index(p_index) {}
@@ -89,8 +96,8 @@ public:
     }
 
 private:
-    const std::vector<Entity>& m_entityArray;
-    const std::vector<T>& m_componentArray;
+    std::span<const Entity> m_entityArray;
+    std::span<const T> m_componentArray;
 
     size_t m_index;
 };
@@ -110,7 +117,7 @@ public:
     virtual size_t GetCount() const = 0;
     virtual Entity GetEntity(size_t p_index) const = 0;
 
-    virtual const std::vector<Entity>& GetEntityArray() const = 0;
+    virtual const EntityArray& GetEntityArray() const = 0;
 
     virtual bool Serialize(Archive& p_archive, uint32_t p_version) = 0;
 };
@@ -126,7 +133,13 @@ public:
     const_iter begin() const { return const_iter(m_entityArray, m_componentArray, 0); }
     const_iter end() const { return const_iter(m_entityArray, m_componentArray, m_componentArray.size()); }
 
-    ComponentManager(size_t p_capacity = 0) { Reserve(p_capacity); }
+    // all the storage, sparse pages included, is allocated from p_resource
+    explicit ComponentManager(size_t p_capacity = 0, std::pmr::memory_resource* p_resource = std::pmr::get_default_resource())
+        : m_componentArray(p_resource),
+          m_entityArray(p_resource),
+          m_sparseSet(p_resource) {
+        Reserve(p_capacity);
+    }
 
     void Reserve(size_t p_capacity);
 
@@ -156,38 +169,54 @@ public:
 
     T& Create(const Entity& p_entity);
 
-    const std::vector<Entity>& GetEntityArray() const override {
+    const EntityArray& GetEntityArray() const override {
         return m_entityArray;
     }
 
     bool Serialize(Archive& p_archive, uint32_t p_version) override;
 
+    // changes whenever components are added or removed, dense indices stay valid as long as it doesn't
+    uint32_t GetVersion() const { return m_version; }
+
 private:
-    std::vector<T> m_componentArray;
-    std::vector<Entity> m_entityArray;
-    std::unordered_map<Entity, size_t> m_lookup;
+    // returns the dense index of p_entity, or SparseSet::INVALID if it's not in this manager
+    uint32_t FindIndex(const Entity& p_entity) const;
+
+    std::pmr::vector<T> m_componentArray;
+    EntityArray m_entityArray;
+    SparseSet m_sparseSet;
+    uint32_t m_version = 0;
 
     friend class ::my::Scene;
-    friend class View<T>;
+    template<Serializable... Ts>
+    friend class View;
 };
 
 class ComponentLibrary {
 public:
+    // the managers registered later allocate their storage from p_resource
+    explicit ComponentLibrary(std::pmr::memory_resource* p_resource = std::pmr::get_default_resource()) : m_resource(p_resource) {}
+
     struct LibraryEntry {
         std::unique_ptr<IComponentManager> m_manager = nullptr;
         uint64_t m_version = 0;
+        std::string m_name;
     };
 
     template<Serializable T>
     inline ComponentManager<T>& RegisterManager(const std::string& p_name, uint64_t p_version = 0) {
-        DEV_ASSERT(m_entries.find(p_name) == m_entries.end());
-        m_entries[p_name].m_manager = std::make_unique<ComponentManager<T>>();
-        m_entries[p_name].m_version = p_version;
-        return static_cast<ComponentManager<T>&>(*(m_entries[p_name].m_manager));
+        const StringId key = StringId::Intern(p_name);
+        DEV_ASSERT(m_entries.find(key) == m_entries.end());
+        LibraryEntry& entry = m_entries[key];
+        entry.m_manager = std::make_unique<ComponentManager<T>>(0, m_resource);
+        entry.m_version = p_version;
+        entry.m_name = p_name;
+        return static_cast<ComponentManager<T>&>(*entry.m_manager);
     }
 
 private:
-    std::unordered_map<std::string, LibraryEntry> m_entries;
+    std::pmr::memory_resource* m_resource;
+    std::unordered_map<StringId, LibraryEntry> m_entries;
 
     friend class ::my::Scene;
 };
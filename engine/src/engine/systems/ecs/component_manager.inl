@@ -10,7 +10,6 @@ void ComponentManager<T>::Reserve(size_t p_capacity) {
     if (p_capacity) {
         m_componentArray.reserve(p_capacity);
         m_entityArray.reserve(p_capacity);
-        m_lookup.reserve(p_capacity);
     }
 }
 
@@ -18,7 +17,8 @@ template<Serializable T>
 void ComponentManager<T>::Clear() {
     m_componentArray.clear();
     m_entityArray.clear();
-    m_lookup.clear();
+    m_sparseSet.Clear();
+    ++m_version;
 }
 
 template<Serializable T>
@@ -26,7 +26,7 @@ void ComponentManager<T>::Copy(const ComponentManager<T>& p_other) {
     Clear();
     m_componentArray = p_other.m_componentArray;
     m_entityArray = p_other.m_entityArray;
-    m_lookup = p_other.m_lookup;
+    m_sparseSet = p_other.m_sparseSet;
 }
 
 template<Serializable T>
@@ -39,15 +39,15 @@ void ComponentManager<T>::Merge(ComponentManager<T>& p_other) {
     const size_t reserved = GetCount() + p_other.GetCount();
     m_componentArray.reserve(reserved);
     m_entityArray.reserve(reserved);
-    m_lookup.reserve(reserved);
 
     for (size_t i = 0; i < p_other.GetCount(); ++i) {
         Entity entity = p_other.m_entityArray[i];
-        DEV_ASSERT(!Contains(entity));
+        DEV_ASSERT(m_sparseSet.Find(entity) == SparseSet::INVALID);
         m_entityArray.push_back(entity);
-        m_lookup[entity] = m_componentArray.size();
+        m_sparseSet.Set(entity, static_cast<uint32_t>(m_componentArray.size()));
         m_componentArray.push_back(std::move(p_other.m_componentArray[i]));
     }
+    ++m_version;
 
     p_other.Clear();
 }
@@ -57,32 +57,40 @@ void ComponentManager<T>::Merge(IComponentManager& p_other) {
     Merge((ComponentManager<T>&)p_other);
 }
 
+template<Serializable T>
+uint32_t ComponentManager<T>::FindIndex(const Entity& p_entity) const {
+    const uint32_t index = m_sparseSet.Find(p_entity);
+    // the sparse set only knows about entity index, compare the full handle to reject stale generations
+    if (index == SparseSet::INVALID || m_entityArray[index] != p_entity) {
+        return SparseSet::INVALID;
+    }
+    return index;
+}
+
 template<Serializable T>
 void ComponentManager<T>::Remove(const Entity& p_entity) {
-    auto it = m_lookup.find(p_entity);
-    if (it == m_lookup.end()) {
+    const uint32_t index = FindIndex(p_entity);
+    if (index == SparseSet::INVALID) {
         return;
     }
 
-    size_t index = it->second;
-    DEV_ASSERT_INDEX(index, m_entityArray.size());
-    m_lookup.erase(it);
-    m_entityArray.erase(m_entityArray.begin() + index);
-    m_componentArray.erase(m_componentArray.begin() + index);
-    for (auto& iter : m_lookup) {
-        DEV_ASSERT(iter.second != index);
-        if (iter.second > index) {
-            --iter.second;
-        }
+    // swap with the last element and pop, so only one sparse entry needs to be patched
+    const uint32_t last = static_cast<uint32_t>(m_entityArray.size() - 1);
+    if (index != last) {
+        m_entityArray[index] = m_entityArray[last];
+        m_componentArray[index] = std::move(m_componentArray[last]);
+        m_sparseSet.Set(m_entityArray[index], index);
     }
+
+    m_sparseSet.Erase(p_entity);
+    m_entityArray.pop_back();
+    m_componentArray.pop_back();
+    ++m_version;
 }
 
 template<Serializable T>
 bool ComponentManager<T>::Contains(const Entity& p_entity) const {
-    if (m_lookup.empty()) {
-        return false;
-    }
-    return m_lookup.find(p_entity) != m_lookup.end();
+    return FindIndex(p_entity) != SparseSet::INVALID;
 }
 
 template<Serializable T>
@@ -99,17 +107,12 @@ const T& ComponentManager<T>::GetComponentByIndex(size_t p_index) const {
 
 template<Serializable T>
 T* ComponentManager<T>::GetComponent(const Entity& p_entity) {
-    if (!p_entity.IsValid() || m_lookup.empty()) {
-        return nullptr;
-    }
-
-    auto it = m_lookup.find(p_entity);
-
-    if (it == m_lookup.end()) {
+    const uint32_t index = FindIndex(p_entity);
+    if (index == SparseSet::INVALID) {
         return nullptr;
     }
 
-    return &m_componentArray[it->second];
+    return &m_componentArray[index];
 }
 
 template<Serializable T>
@@ -123,13 +126,14 @@ T& ComponentManager<T>::Create(const Entity& p_entity) {
     DEV_ASSERT(p_entity.IsValid());
 
     const size_t componentCount = m_componentArray.size();
-    DEV_ASSERT(m_lookup.find(p_entity) == m_lookup.end());
+    // also catches a different generation of the same slot still being alive
+    DEV_ASSERT(m_sparseSet.Find(p_entity) == SparseSet::INVALID);
     DEV_ASSERT(m_entityArray.size() == componentCount);
-    DEV_ASSERT(m_lookup.size() == componentCount);
 
-    m_lookup[p_entity] = componentCount;
+    m_sparseSet.Set(p_entity, static_cast<uint32_t>(componentCount));
     m_componentArray.emplace_back();
     m_entityArray.push_back(p_entity);
+    ++m_version;
     return m_componentArray.back();
 }
 
@@ -167,7 +171,7 @@ bool ComponentManager<T>::Serialize(Archive& p_archive, uint32_t p_version) {
         }
         for (size_t i = 0; i < count; ++i) {
             p_archive >> m_entityArray[i];
-            m_lookup[m_entityArray[i]] = i;
+            m_sparseSet.Set(m_entityArray[i], static_cast<uint32_t>(i));
         }
     }
 
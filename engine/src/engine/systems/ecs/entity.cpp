@@ -4,11 +4,46 @@ namespace my::ecs {
 
 const Entity Entity::INVALID{};
 
+static struct {
+    std::mutex lock;
+    // handles in the free list already carry their next generation
+    std::vector<Entity> freeList;
+    std::atomic_uint32_t freeCount;
+} s_entityGlob;
+
 Entity Entity::Create() {
-    CRASH_COND_MSG(s_id.load() == MAX_ID, "max number of entity allocated, did you forget to call setSeed()?");
+    if (s_entityGlob.freeCount.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard lock(s_entityGlob.lock);
+        if (!s_entityGlob.freeList.empty()) {
+            Entity entity = s_entityGlob.freeList.back();
+            s_entityGlob.freeList.pop_back();
+            s_entityGlob.freeCount.fetch_sub(1, std::memory_order_relaxed);
+            return entity;
+        }
+    }
+
+    CRASH_COND_MSG(s_id.load() == MAX_ID, "seed id is not set, did you forget to call setSeed()?");
     CRASH_COND_MSG(s_id.load() == 0, "seed id is 0, did you forget to call setSeed()?");
-    Entity entity(s_id.fetch_add(1));
-    return entity;
+    const uint32_t index = s_id.fetch_add(1);
+    CRASH_COND_MSG(index > MAX_INDEX, "max number of entity allocated");
+    return Entity(index, 0);
+}
+
+void Entity::Destroy(const Entity& p_entity) {
+    if (!p_entity.IsValid()) {
+        return;
+    }
+
+    // retire the slot instead of wrapping around to a generation that might still be referenced
+    const uint32_t generation = p_entity.GetGeneration() + 1;
+    if (generation > GENERATION_MASK) {
+        return;
+    }
+
+    const Entity recycled(p_entity.GetIndex(), generation);
+    std::lock_guard lock(s_entityGlob.lock);
+    s_entityGlob.freeList.push_back(recycled);
+    s_entityGlob.freeCount.fetch_add(1, std::memory_order_relaxed);
 }
 
 uint32_t Entity::GetSeed() {
@@ -16,6 +51,10 @@ uint32_t Entity::GetSeed() {
 }
 
 void Entity::SetSeed(uint32_t p_seed) {
+    // a new seed means a new world, recycled handles from the old one are no longer meaningful
+    std::lock_guard lock(s_entityGlob.lock);
+    s_entityGlob.freeList.clear();
+    s_entityGlob.freeCount.store(0, std::memory_order_relaxed);
     s_id = p_seed;
 }
 
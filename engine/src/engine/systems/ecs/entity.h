@@ -6,16 +6,29 @@ class Archive;
 
 namespace my::ecs {
 
+// An entity handle packs a slot index and a generation into 32 bits.
+// When an entity is destroyed, its index is put on a free list and reused with the next generation,
+// so stale handles never compare equal to the new owner of the slot.
+// Generation 0 handles have id == index, which keeps ids saved by older versions valid.
 class Entity {
 public:
+    static constexpr uint32_t INDEX_BITS = 24;
+    static constexpr uint32_t GENERATION_BITS = 32 - INDEX_BITS;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = (1u << GENERATION_BITS) - 1;
+
     static constexpr size_t INVALID_INDEX = ~0llu;
     static constexpr uint32_t INVALID_ID = 0;
     static constexpr uint32_t MAX_ID = ~0u;
+    static constexpr uint32_t MAX_INDEX = INDEX_MASK;
 
     explicit constexpr Entity() : m_id(INVALID_ID) {}
 
     explicit constexpr Entity(uint32_t p_handle) : m_id(p_handle) {}
 
+    explicit constexpr Entity(uint32_t p_index, uint32_t p_generation)
+        : m_id((p_index & INDEX_MASK) | ((p_generation & GENERATION_MASK) << INDEX_BITS)) {}
+
     ~Entity() = default;
 
     bool operator==(const Entity& p_rhs) const { return m_id == p_rhs.m_id; }
@@ -28,7 +41,13 @@ public:
 
     constexpr uint32_t GetId() const { return m_id; }
 
+    constexpr uint32_t GetIndex() const { return m_id & INDEX_MASK; }
+
+    constexpr uint32_t GetGeneration() const { return m_id >> INDEX_BITS; }
+
     static Entity Create();
+    // recycles the index of p_entity, the entity must not be referenced by any component manager afterwards
+    static void Destroy(const Entity& p_entity);
     static uint32_t GetSeed();
     static void SetSeed(uint32_t p_seed = INVALID_ID + 1);
 
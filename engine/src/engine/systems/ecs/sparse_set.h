@@ -0,0 +1,57 @@
+#pragma once
+#include <memory_resource>
+
+#include "entity.h"
+
+namespace my::ecs {
+
+// Maps entity index to a dense array index. The sparse array is split into pages that are
+// allocated on demand, so a few entities with large indices don't allocate the whole range.
+// Only the index part of the entity is stored, the owner compares the full handle stored
+// in its dense entity array to reject stale generations.
+class SparseSet {
+public:
+    static constexpr uint32_t PAGE_BITS = 12;
+    static constexpr uint32_t PAGE_SIZE = 1u << PAGE_BITS;
+    static constexpr uint32_t PAGE_MASK = PAGE_SIZE - 1;
+    static constexpr uint32_t INVALID = ~0u;
+
+    // the pages are allocated from p_resource too
+    explicit SparseSet(std::pmr::memory_resource* p_resource = std::pmr::get_default_resource()) : m_pages(p_resource) {}
+
+    uint32_t Find(const Entity& p_entity) const {
+        const uint32_t index = p_entity.GetIndex();
+        const uint32_t page = index >> PAGE_BITS;
+        if (page >= m_pages.size() || m_pages[page].empty()) {
+            return INVALID;
+        }
+        return m_pages[page][index & PAGE_MASK];
+    }
+
+    void Set(const Entity& p_entity, uint32_t p_dense_index) {
+        const uint32_t index = p_entity.GetIndex();
+        const uint32_t page = index >> PAGE_BITS;
+        if (page >= m_pages.size()) {
+            m_pages.resize(page + 1);
+        }
+        if (m_pages[page].empty()) {
+            m_pages[page].resize(PAGE_SIZE, INVALID);
+        }
+        m_pages[page][index & PAGE_MASK] = p_dense_index;
+    }
+
+    void Erase(const Entity& p_entity) {
+        const uint32_t index = p_entity.GetIndex();
+        const uint32_t page = index >> PAGE_BITS;
+        if (page < m_pages.size() && !m_pages[page].empty()) {
+            m_pages[page][index & PAGE_MASK] = INVALID;
+        }
+    }
+
+    void Clear() { m_pages.clear(); }
+
+private:
+    std::pmr::vector<std::pmr::vector<uint32_t>> m_pages;
+};
+
+}  // namespace my::ecs
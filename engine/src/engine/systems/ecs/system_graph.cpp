@@ -0,0 +1,80 @@
+#include "system_graph.h"
+
+#include <algorithm>
+
+namespace my::ecs {
+
+using jobsystem::Context;
+using jobsystem::JobHandle;
+
+static bool Conflicts(const SystemDesc& p_lhs, const SystemDesc& p_rhs) {
+    return (p_lhs.writes & (p_rhs.reads | p_rhs.writes)) || (p_lhs.reads & p_rhs.writes);
+}
+
+void SystemGraph::Register(SystemDesc&& p_desc) {
+    DEV_ASSERT(p_desc.run || p_desc.update);
+    m_systems.emplace_back(std::move(p_desc));
+    m_dirty = true;
+}
+
+const std::vector<uint32_t>& SystemGraph::GetDependencies(uint32_t p_index) {
+    if (m_dirty) {
+        Build();
+    }
+    return m_dependencies[p_index];
+}
+
+void SystemGraph::Build() {
+    const uint32_t count = static_cast<uint32_t>(m_systems.size());
+    m_dependencies.assign(count, {});
+    // earlier systems this one waits for, directly or through another dependency
+    std::vector<std::vector<bool>> reachable(count, std::vector<bool>(count, false));
+
+    for (uint32_t system = 0; system < count; ++system) {
+        auto& reach = reachable[system];
+        // the latest systems first, once one of them is a dependency the ones it waits for are covered
+        for (uint32_t other = system; other-- > 0;) {
+            if (reach[other] || !Conflicts(m_systems[system], m_systems[other])) {
+                continue;
+            }
+
+            m_dependencies[system].push_back(other);
+            reach[other] = true;
+            for (uint32_t index = 0; index < other; ++index) {
+                if (reachable[other][index]) {
+                    reach[index] = true;
+                }
+            }
+        }
+        std::reverse(m_dependencies[system].begin(), m_dependencies[system].end());
+    }
+
+    m_dirty = false;
+}
+
+JobHandle SystemGraph::Run(Context& p_context) {
+    if (m_dirty) {
+        Build();
+    }
+
+    m_handles.resize(m_systems.size());
+    std::vector<JobHandle> dependencies;
+    for (size_t system = 0; system < m_systems.size(); ++system) {
+        dependencies.clear();
+        for (uint32_t dependency : m_dependencies[system]) {
+            dependencies.push_back(m_handles[dependency]);
+        }
+
+        SystemDesc& desc = m_systems[system];
+        if (desc.run) {
+            const JobHandle dependency = dependencies.size() == 1 ? dependencies.front() : p_context.WhenAll(dependencies);
+            m_handles[system] = desc.run(p_context, dependency);
+        } else {
+            m_handles[system] = p_context.Dispatch(1, 1, [&desc](jobsystem::JobArgs) { desc.update(); }, dependencies);
+        }
+    }
+
+    return p_context.WhenAll(m_handles);
+}
+
+}  // namespace my::ecs
@@ -0,0 +1,50 @@
+#pragma once
+#include "engine/systems/job_system/job_system.h"
+
+namespace my::ecs {
+
+// one bit per component type, the owner of the components decides which, see Scene::GetComponentMask()
+using ComponentMask = uint64_t;
+
+struct SystemDesc {
+    using RunFunc = std::function<jobsystem::JobHandle(jobsystem::Context&, const jobsystem::JobHandle&)>;
+
+    std::string name;
+    ComponentMask reads = 0;
+    ComponentMask writes = 0;
+
+    // for systems that dispatch their own jobs: starts them once p_dependency is done and returns a handle
+    // that completes with them
+    RunFunc run;
+    // for everything else: runs as a single job, used when run is empty
+    std::function<void()> update;
+};
+
+// Systems declare the components they read and write. A system waits for the systems registered before it
+// that write what it touches, or touch what it writes; the rest run concurrently. Registration order only
+// matters between conflicting systems.
+class SystemGraph {
+public:
+    // not while the systems are running
+    void Register(SystemDesc&& p_desc);
+
+    // schedules every system on p_context, the handle completes once all of them did
+    jobsystem::JobHandle Run(jobsystem::Context& p_context);
+
+    size_t GetSystemCount() const { return m_systems.size(); }
+
+    const SystemDesc& GetSystem(uint32_t p_index) const { return m_systems[p_index]; }
+
+    // systems p_index directly waits for
+    const std::vector<uint32_t>& GetDependencies(uint32_t p_index);
+
+private:
+    void Build();
+
+    std::vector<SystemDesc> m_systems;
+    std::vector<std::vector<uint32_t>> m_dependencies;
+    std::vector<jobsystem::JobHandle> m_handles;
+    bool m_dirty = false;
+};
+
+}  // namespace my::ecs
@@ -3,103 +3,184 @@
 
 namespace my::ecs {
 
-// @TODO: combine View with reserved allocator and recycling
-// so when removing a component, we don't need to remove it from the array,
-// but we can invalidate it, and when creating View, View can skip it
+// Views don't own or copy anything, they iterate the dense arrays of the component managers in place.
+// Creating or removing components of the viewed types invalidates the view.
+// A const view yields const components.
 
+#pragma region VIEW_SINGLE
 template<Serializable T>
-class View {
-    using ViewContainer = std::vector<std::pair<Entity, int>>;
-
+class View<T> {
 public:
-    template<typename U>
-        requires std::is_same_v<T, std::remove_const_t<U>>
-    class Iterator;
-
-    using iter = Iterator<T>;
-    using const_iter = Iterator<const T>;
-
-#pragma region ITERATOR
     template<typename U>
         requires std::is_same_v<T, std::remove_const_t<U>>
     class Iterator {
         using Self = Iterator<U>;
 
     public:
-        Iterator(const ViewContainer& p_container,
-                 const ComponentManager<T>& p_manager,
-                 uint32_t p_index) : m_container(p_container),
-                                     m_manager(p_manager),
-                                     m_index(p_index) {}
+        Iterator(const Entity* p_entity, U* p_component) : m_entity(p_entity),
+                                                           m_component(p_component) {}
 
-        Self operator++(int) const {
+        Self operator++(int) {
             Self tmp = *this;
-            ++m_index;
+            ++m_entity;
+            ++m_component;
             return tmp;
         }
 
-        Self operator--(int) const {
+        Self operator--(int) {
             Self tmp = *this;
-            --m_index;
+            --m_entity;
+            --m_component;
             return tmp;
         }
 
         Self& operator++() {
-            ++m_index;
+            ++m_entity;
+            ++m_component;
             return *this;
         }
 
         Self& operator--() {
-            --m_index;
+            --m_entity;
+            --m_component;
             return *this;
         }
 
-        bool operator==(const Self& p_rhs) const { return m_index == p_rhs.m_index; }
-        bool operator!=(const Self& p_rhs) const { return m_index != p_rhs.m_index; }
+        bool operator==(const Self& p_rhs) const { return m_entity == p_rhs.m_entity; }
+        bool operator!=(const Self& p_rhs) const { return m_entity != p_rhs.m_entity; }
 
-        auto operator*() -> std::pair<Entity, U&> {
-            Entity entity = m_container[m_index].first;
-            int index = m_container[m_index].second;
-            U& component = ((ComponentManager<T>&)m_manager).GetComponentByIndex(index);
-            return std::pair<Entity, U&>(entity, component);
+        auto operator*() const -> std::pair<Entity, U&> {
+            return std::pair<Entity, U&>(*m_entity, *m_component);
         }
 
-        auto operator*() const -> std::pair<Entity, U&> {
-            Entity entity = m_container[m_index].first;
-            int index = m_container[m_index].second;
-            U& component = m_manager.GetComponentByIndex(index);
-            return std::pair<Entity, U&>(entity, component);
+    private:
+        const Entity* m_entity;
+        U* m_component;
+    };
+
+    using iter = Iterator<T>;
+    using const_iter = Iterator<const T>;
+
+    // the view carries the constness, the manager is only accessed through const methods of a const view
+    View(const ComponentManager<T>& p_manager) : m_manager(const_cast<ComponentManager<T>*>(&p_manager)) {}
+
+    iter begin() { return iter(m_manager->m_entityArray.data(), m_manager->m_componentArray.data()); }
+    iter end() { return iter(m_manager->m_entityArray.data() + GetSize(), m_manager->m_componentArray.data() + GetSize()); }
+
+    const_iter begin() const { return const_iter(m_manager->m_entityArray.data(), m_manager->m_componentArray.data()); }
+    const_iter end() const { return const_iter(m_manager->m_entityArray.data() + GetSize(), m_manager->m_componentArray.data() + GetSize()); }
+
+    uint32_t GetSize() const { return static_cast<uint32_t>(m_manager->m_entityArray.size()); }
+
+private:
+    ComponentManager<T>* m_manager;
+};
+#pragma endregion VIEW_SINGLE
+
+#pragma region VIEW_JOIN
+// Iterates entities that have all the requested components. Iteration is driven by the smallest
+// manager, the other components are looked up through their sparse sets.
+template<Serializable T1, Serializable T2, Serializable... Ts>
+class View<T1, T2, Ts...> {
+    static constexpr size_t COUNT = 2 + sizeof...(Ts);
+    using Managers = std::tuple<ComponentManager<T1>*, ComponentManager<T2>*, ComponentManager<Ts>*...>;
+    using Indices = std::array<uint32_t, COUNT>;
+
+public:
+    template<bool IS_CONST>
+    class Iterator {
+        using Self = Iterator<IS_CONST>;
+
+        template<typename U>
+        using Ref = std::conditional_t<IS_CONST, const U&, U&>;
+
+    public:
+        Iterator(const View* p_view, size_t p_cursor) : m_view(p_view), m_cursor(p_cursor) {
+            SkipInvalid();
+        }
+
+        Self operator++(int) {
+            Self tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        Self& operator++() {
+            ++m_cursor;
+            SkipInvalid();
+            return *this;
+        }
+
+        bool operator==(const Self& p_rhs) const { return m_cursor == p_rhs.m_cursor; }
+        bool operator!=(const Self& p_rhs) const { return m_cursor != p_rhs.m_cursor; }
+
+        auto operator*() const -> std::tuple<Entity, Ref<T1>, Ref<T2>, Ref<Ts>...> {
+            return Dereference(std::make_index_sequence<COUNT>());
         }
 
     private:
-        const ViewContainer& m_container;
-        const ComponentManager<T>& m_manager;
+        void SkipInvalid() {
+            const EntityArray& entities = *m_view->m_driver;
+            for (; m_cursor < entities.size(); ++m_cursor) {
+                if (m_view->FindIndices(entities[m_cursor], m_indices)) {
+                    break;
+                }
+            }
+        }
+
+        template<size_t... I>
+        auto Dereference(std::index_sequence<I...>) const -> std::tuple<Entity, Ref<T1>, Ref<T2>, Ref<Ts>...> {
+            return std::tuple<Entity, Ref<T1>, Ref<T2>, Ref<Ts>...>(
+                (*m_view->m_driver)[m_cursor],
+                std::get<I>(m_view->m_managers)->m_componentArray[m_indices[I]]...);
+        }
 
-        uint32_t m_index{ 0 };
+        const View* m_view;
+        size_t m_cursor;
+        Indices m_indices{};
     };
-#pragma endregion ITERATOR
 
-    View(const ComponentManager<T>& p_manager) : m_manager(p_manager), m_size(static_cast<uint32_t>(p_manager.GetCount())) {
-        const int size = (int)p_manager.GetCount();
-        for (int i = 0; i < size; ++i) {
-            m_container.emplace_back(std::make_pair(m_manager.m_entityArray[i], i));
-        }
+    using iter = Iterator<false>;
+    using const_iter = Iterator<true>;
+
+    View(const ComponentManager<T1>& p_manager_1,
+         const ComponentManager<T2>& p_manager_2,
+         const ComponentManager<Ts>&... p_managers)
+        : m_managers(const_cast<ComponentManager<T1>*>(&p_manager_1),
+                     const_cast<ComponentManager<T2>*>(&p_manager_2),
+                     const_cast<ComponentManager<Ts>*>(&p_managers)...) {
+        // drive the iteration from the smallest pool
+        std::apply([this](auto*... p_manager) { (SelectDriver(p_manager->m_entityArray), ...); }, m_managers);
     }
 
-    View(const View<T>&) = default;
-
-    iter begin() { return iter(m_container, m_manager, 0); }
-    iter end() { return iter(m_container, m_manager, m_size); }
+    iter begin() { return iter(this, 0); }
+    iter end() { return iter(this, m_driver->size()); }
 
-    const_iter begin() const { return const_iter(m_container, m_manager, 0); }
-    const_iter end() const { return const_iter(m_container, m_manager, m_size); }
+    const_iter begin() const { return const_iter(this, 0); }
+    const_iter end() const { return const_iter(this, m_driver->size()); }
 
-    uint32_t GetSize() const { return m_size; }
+    // upper bound of the number of entities the view visits
+    uint32_t GetSize() const { return static_cast<uint32_t>(m_driver->size()); }
 
 private:
-    ViewContainer m_container;
-    const ComponentManager<T>& m_manager;
-    uint32_t m_size;
+    void SelectDriver(const EntityArray& p_entities) {
+        if (!m_driver || p_entities.size() < m_driver->size()) {
+            m_driver = &p_entities;
+        }
+    }
+
+    bool FindIndices(const Entity& p_entity, Indices& p_out_indices) const {
+        return FindIndicesImpl(p_entity, p_out_indices, std::make_index_sequence<COUNT>());
+    }
+
+    template<size_t... I>
+    bool FindIndicesImpl(const Entity& p_entity, Indices& p_out_indices, std::index_sequence<I...>) const {
+        return (((p_out_indices[I] = std::get<I>(m_managers)->FindIndex(p_entity)) != SparseSet::INVALID) && ...);
+    }
+
+    Managers m_managers;
+    const EntityArray* m_driver = nullptr;
 };
+#pragma endregion VIEW_JOIN
 
 }  // namespace my::ecs
@@ -1,96 +1,516 @@
 #include "job_system.h"
 
-#include "engine/core/base/thread_safe_ring_buffer.h"
+#include "engine/core/base/backoff.h"
+#include "engine/core/base/mpmc_ring_buffer.h"
+#include "engine/core/base/work_stealing_queue.h"
 #include "engine/core/debugger/profiler.h"
 #include "engine/core/os/threads.h"
-#include "engine/math/geomath.h"
 
 namespace my::jobsystem {
 
-static struct
-{
-    std::condition_variable wakeCondition;
-    std::mutex wakeMutex;
-    ThreadSafeRingBuffer<Job, 128> jobQueue;
+static constexpr size_t WORKER_QUEUE_SIZE = 4096;
+static constexpr size_t INJECTION_QUEUE_SIZE = 4096;
+
+// Background jobs always go through the injection queue, they are coarse enough not to care about locality
+// and would otherwise sit behind frame work in the worker's own queue.
+static constexpr int LOCAL_QUEUE_COUNT = JOB_PRIORITY_BACKGROUND;
+
+struct alignas(64) Worker {
+    std::array<WorkStealingQueue<Job*, WORKER_QUEUE_SIZE>, LOCAL_QUEUE_COUNT> queues;
+};
+
+// Jobs dispatched from threads that are not job workers (main thread) go to the injection queue. Big
+// dispatches can outgrow the ring buffer, the rest spills into a locked overflow list.
+struct InjectionQueue {
+    MpmcRingBuffer<Job*, INJECTION_QUEUE_SIZE> jobs;
+
+    alignas(64) std::atomic_int overflowCount;
+    std::mutex overflowLock;
+    std::deque<Job*> overflow;
+};
+
+struct alignas(64) JobCounter {
+    std::atomic_int value;
+};
+
+static struct {
+    // sized once by Initialize(), before the worker threads start
+    std::unique_ptr<Worker[]> workers;
+    uint32_t workerCount = 0;
+    std::array<InjectionQueue, JOB_PRIORITY_COUNT> injectionQueues;
+
+    // number of jobs sitting in any queue, per priority, used to skip empty lanes and to decide if workers
+    // can go to sleep
+    std::array<JobCounter, JOB_PRIORITY_COUNT> queuedJobs;
+    // a worker takes a slot to run a background job, there are fewer slots than workers so frame jobs
+    // always find a free worker. Without workers, the waiting thread needs the one slot to run them itself.
+    alignas(64) std::atomic_int backgroundSlots = 1;
+
+    // idle workers park on workEpoch, bumped whenever jobs get pushed
+    alignas(64) std::atomic_uint32_t workEpoch;
+    std::atomic_int sleepingWorkers;
+    // waiting threads park on completionEpoch, bumped whenever a batch or a context completes
+    alignas(64) std::atomic_uint32_t completionEpoch;
+    std::atomic_int parkedWaiters;
 } s_glob;
 
-static bool DoWork() {
-    Job job;
-    if (!s_glob.jobQueue.pop_front(job)) {
+static thread_local int s_workerIndex = -1;
+static thread_local uint32_t s_stealSeed = 0;
+static thread_local JobPriority s_runningPriority = JOB_PRIORITY_NORMAL;
+// background jobs the thread is running, nested ones help with their own waits without taking a slot
+static thread_local int s_backgroundDepth = 0;
+
+// The epoch is bumped before sleepingWorkers is read, and a worker counts itself as sleeping before it reads
+// the epoch. Either the worker sees the new epoch and doesn't park, or it is counted here and gets notified.
+static void WakeWorkers(int p_count) {
+    s_glob.workEpoch.fetch_add(1);
+    if (s_glob.sleepingWorkers.load() == 0) {
+        return;
+    }
+
+    if (p_count == 1) {
+        s_glob.workEpoch.notify_one();
+    } else {
+        s_glob.workEpoch.notify_all();
+    }
+}
+
+// same handshake as WakeWorkers(), only touches globals so it's safe after the context is gone
+static void NotifyWaiters() {
+    s_glob.completionEpoch.fetch_add(1);
+    if (s_glob.parkedWaiters.load() > 0) {
+        s_glob.completionEpoch.notify_all();
+    }
+}
+
+static bool HasRunnableJobs() {
+    if (s_glob.queuedJobs[JOB_PRIORITY_CRITICAL].value.load() > 0 ||
+        s_glob.queuedJobs[JOB_PRIORITY_NORMAL].value.load() > 0) {
+        return true;
+    }
+    return s_glob.queuedJobs[JOB_PRIORITY_BACKGROUND].value.load() > 0 && s_glob.backgroundSlots.load() > 0;
+}
+
+static bool AcquireBackgroundSlot() {
+    int slots = s_glob.backgroundSlots.load();
+    while (slots > 0) {
+        if (s_glob.backgroundSlots.compare_exchange_weak(slots, slots - 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void ReleaseBackgroundSlot() {
+    s_glob.backgroundSlots.fetch_add(1);
+    // a worker could have gone to sleep because all the slots were taken
+    if (s_glob.queuedJobs[JOB_PRIORITY_BACKGROUND].value.load() > 0) {
+        WakeWorkers(1);
+    }
+}
+
+// the batch can complete and be freed by another thread as soon as its last job is pushed, only the raw
+// pointers are used past that point
+static void PushJobs(JobPriority p_priority, Job* p_begin, Job* p_end) {
+    s_glob.queuedJobs[p_priority].value.fetch_add(static_cast<int>(p_end - p_begin));
+
+    Job* it = p_begin;
+    if (s_workerIndex >= 0 && p_priority < LOCAL_QUEUE_COUNT) {
+        auto& queue = s_glob.workers[s_workerIndex].queues[p_priority];
+        for (; it != p_end; ++it) {
+            if (!queue.push(it)) {
+                break;
+            }
+        }
+    }
+
+    auto& injection = s_glob.injectionQueues[p_priority];
+    for (; it != p_end; ++it) {
+        if (!injection.jobs.push_back(it)) {
+            break;
+        }
+    }
+
+    if (it != p_end) {
+        std::lock_guard lock(injection.overflowLock);
+        injection.overflowCount.fetch_add(static_cast<int>(p_end - it));
+        for (; it != p_end; ++it) {
+            injection.overflow.push_back(it);
+        }
+    }
+
+    WakeWorkers(static_cast<int>(p_end - p_begin));
+}
+
+static bool PopInjectedJob(JobPriority p_priority, Job*& p_out_job) {
+    auto& injection = s_glob.injectionQueues[p_priority];
+    if (injection.jobs.pop_front(p_out_job)) {
+        return true;
+    }
+
+    if (injection.overflowCount.load() == 0) {
+        return false;
+    }
+
+    std::lock_guard lock(injection.overflowLock);
+    if (injection.overflow.empty()) {
+        return false;
+    }
+
+    p_out_job = injection.overflow.front();
+    injection.overflow.pop_front();
+
+    // move what fits back to the ring buffer, so the other threads don't have to come here
+    int moved = 1;
+    while (!injection.overflow.empty() && injection.jobs.push_back(injection.overflow.front())) {
+        injection.overflow.pop_front();
+        ++moved;
+    }
+    injection.overflowCount.fetch_sub(moved);
+    return true;
+}
+
+static bool StealJob(JobPriority p_priority, Job*& p_out_job) {
+    // xorshift, so thieves don't all hammer the same victim
+    uint32_t seed = s_stealSeed ? s_stealSeed : static_cast<uint32_t>(s_workerIndex + 2) * 2654435761u;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    s_stealSeed = seed;
+
+    const uint32_t worker_count = s_glob.workerCount;
+    if (worker_count == 0) {
+        return false;
+    }
+
+    const uint32_t start = seed % worker_count;
+    for (uint32_t i = 0; i < worker_count; ++i) {
+        const uint32_t victim = (start + i) % worker_count;
+        if (static_cast<int>(victim) == s_workerIndex) {
+            continue;
+        }
+        if (s_glob.workers[victim].queues[p_priority].steal(p_out_job)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// p_out_slot is set if a background slot was taken for the job
+static bool FindBackgroundJob(Job*& p_out_job, bool& p_out_slot) {
+    const bool needs_slot = s_backgroundDepth == 0;
+    if (needs_slot && !AcquireBackgroundSlot()) {
+        return false;
+    }
+
+    if (PopInjectedJob(JOB_PRIORITY_BACKGROUND, p_out_job)) {
+        p_out_slot = needs_slot;
+        return true;
+    }
+
+    if (needs_slot) {
+        s_glob.backgroundSlots.fetch_add(1);
+    }
+    return false;
+}
+
+// lanes are searched from the most urgent one, up to p_max_priority
+static bool FindJob(JobPriority p_max_priority, Job*& p_out_job, bool& p_out_slot) {
+    for (int index = 0; index <= p_max_priority; ++index) {
+        const JobPriority priority = static_cast<JobPriority>(index);
+        if (s_glob.queuedJobs[priority].value.load(std::memory_order_relaxed) <= 0) {
+            continue;
+        }
+
+        if (priority == JOB_PRIORITY_BACKGROUND) {
+            return FindBackgroundJob(p_out_job, p_out_slot);
+        }
+
+        if (s_workerIndex >= 0 && s_glob.workers[s_workerIndex].queues[priority].pop(p_out_job)) {
+            return true;
+        }
+        if (PopInjectedJob(priority, p_out_job)) {
+            return true;
+        }
+        if (StealJob(priority, p_out_job)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Waiting threads only help with jobs at least as urgent as the ones they wait for, so the main thread never
+// picks up a long background job while it waits on frame work. Without workers, nobody else would run them.
+static JobPriority GetHelpLimit(JobPriority p_priority) {
+    return s_glob.workerCount == 0 ? JOB_PRIORITY_BACKGROUND : p_priority;
+}
+
+static void ScheduleBatch(Batch& p_batch);
+
+// called once per batch, by whoever finishes its last group or releases its last dependency
+static void CompleteBatch(Batch& p_batch) {
+    Context* ctx = p_batch.ctx;
+    std::vector<Batch*> continuations;
+    {
+        std::lock_guard lock(p_batch.lock);
+        p_batch.done = true;
+        continuations.swap(p_batch.continuations);
+    }
+    NotifyWaiters();
+
+    for (Batch* continuation : continuations) {
+        if (continuation->pendingDependencies.fetch_sub(1) == 1) {
+            ScheduleBatch(*continuation);
+        }
+    }
+
+    if (!ctx) {
+        // detached batch from RunAsync(), nothing can refer to it anymore
+        delete &p_batch;
+        return;
+    }
+
+    // the batch itself counts as a task, so the context can't throw it away before this point
+    ctx->DecreaseTaskCount();
+}
+
+static void ScheduleBatch(Batch& p_batch) {
+    if (p_batch.jobs.empty()) {
+        CompleteBatch(p_batch);
+        return;
+    }
+
+    Job* jobs = p_batch.jobs.data();
+    PushJobs(p_batch.priority, jobs, jobs + p_batch.jobs.size());
+}
+
+static bool DoWork(JobPriority p_max_priority) {
+    Job* job = nullptr;
+    bool background_slot = false;
+    if (!FindJob(p_max_priority, job, background_slot)) {
         return false;
     }
 
-    for (uint32_t i = job.groupJobOffset; i < job.groupJobEnd; ++i) {
+    Batch& batch = *job->batch;
+    const JobPriority priority = batch.priority;
+    s_glob.queuedJobs[priority].value.fetch_sub(1);
+
+    const JobPriority previous_priority = s_runningPriority;
+    s_runningPriority = priority;
+    if (priority == JOB_PRIORITY_BACKGROUND) {
+        ++s_backgroundDepth;
+    }
+
+    for (uint32_t i = job->groupJobOffset; i < job->groupJobEnd; ++i) {
         JobArgs args;
-        args.groupId = job.groupId;
+        args.groupId = job->groupId;
         args.jobIndex = i;
-        args.groupIndex = i - job.groupJobOffset;
-        job.task(args);
+        args.groupIndex = i - job->groupJobOffset;
+        batch.task(args);
+    }
+
+    s_runningPriority = previous_priority;
+    if (priority == JOB_PRIORITY_BACKGROUND) {
+        --s_backgroundDepth;
     }
 
-    job.ctx->DecreaseTaskCount();
+    // continuations are released before the task count drops, the context is only allowed to throw the
+    // batches away once nobody touches them anymore
+    Context* ctx = batch.ctx;
+    if (batch.pendingGroups.fetch_sub(1) == 1) {
+        CompleteBatch(batch);
+    }
+
+    if (ctx) {
+        ctx->DecreaseTaskCount();
+    }
+    if (background_slot) {
+        ReleaseBackgroundSlot();
+    }
     return true;
 }
 
+// Runs jobs until p_done holds, backing off when there is nothing to help with. Only threads that aren't
+// workers park in the end: a worker parked in a nested wait could sit on jobs nobody else gets to, so workers
+// keep yielding instead. Without workers the waiting thread runs everything itself and never parks.
+template<typename PRED>
+static void HelpUntil(JobPriority p_limit, PRED&& p_done) {
+    Backoff backoff;
+    while (!p_done()) {
+        if (DoWork(p_limit)) {
+            backoff.Reset();
+            continue;
+        }
+        if (backoff.Pause()) {
+            continue;
+        }
+        if (s_workerIndex >= 0 || s_glob.workerCount == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        s_glob.parkedWaiters.fetch_add(1);
+        const uint32_t epoch = s_glob.completionEpoch.load();
+        if (!p_done()) {
+            s_glob.completionEpoch.wait(epoch);
+        }
+        s_glob.parkedWaiters.fetch_sub(1);
+    }
+}
+
 void WorkerMain() {
+    s_workerIndex = thread::GetJobWorkerIndex();
+    DEV_ASSERT(s_workerIndex >= 0 && static_cast<uint32_t>(s_workerIndex) < s_glob.workerCount);
+
+    Backoff backoff;
     for (;;) {
         if (thread::ShutdownRequested()) {
             break;
         }
 
-        if (!DoWork()) {
-            std::unique_lock<std::mutex> lock(s_glob.wakeMutex);
-            s_glob.wakeCondition.wait(lock);
+        if (DoWork(JOB_PRIORITY_BACKGROUND)) {
+            backoff.Reset();
+            continue;
+        }
+        if (backoff.Pause()) {
+            continue;
+        }
+
+        s_glob.sleepingWorkers.fetch_add(1);
+        const uint32_t epoch = s_glob.workEpoch.load();
+        if (!HasRunnableJobs() && !thread::ShutdownRequested()) {
+            s_glob.workEpoch.wait(epoch);
         }
+        s_glob.sleepingWorkers.fetch_sub(1);
+        backoff.Reset();
     }
 }
 
-bool Initialize() {
+bool Initialize(uint32_t p_worker_count) {
+    s_glob.workers = std::make_unique<Worker[]>(p_worker_count);
+    s_glob.workerCount = p_worker_count;
+
+    // background jobs may take every worker but a quarter, so the frame keeps some workers to itself
+    const uint32_t reserved = p_worker_count > 1 ? std::max(p_worker_count / 4, 1u) : 0;
+    s_glob.backgroundSlots = static_cast<int>(std::max(p_worker_count - reserved, 1u));
     return true;
 }
 
 void Finalize() {
-    s_glob.wakeCondition.notify_all();
+    // shutdown was requested already, the new epoch makes sure no worker parks again
+    s_glob.workEpoch.fetch_add(1);
+    s_glob.workEpoch.notify_all();
 }
 
-void Context::Dispatch(uint32_t p_job_count, uint32_t p_group_size, const std::function<void(JobArgs)>& p_task) {
-    // DEV_ASSERT(thread::isMainThread());
+uint32_t GetWorkerCount() {
+    return s_glob.workerCount;
+}
 
-    if (p_job_count == 0 || p_group_size == 0) {
-        return;
+JobPriority GetCurrentPriority() {
+    return s_runningPriority;
+}
+
+void RunAsyncImpl(JobPriority p_priority, JobTask&& p_task) {
+    Batch* batch = new Batch;
+    batch->ctx = nullptr;
+    batch->priority = p_priority;
+    batch->task = std::move(p_task);
+    batch->pendingGroups = 1;
+    batch->pendingDependencies = 0;
+
+    Job& job = batch->jobs.emplace_back();
+    job.batch = batch;
+    job.groupId = 0;
+    job.groupJobOffset = 0;
+    job.groupJobEnd = 1;
+
+    ScheduleBatch(*batch);
+}
+
+void RunJobsUntil(JobPriority p_priority, const std::function<bool()>& p_done) {
+    HelpUntil(p_priority, p_done);
+}
+
+Context::Context() : m_priority(GetCurrentPriority()) {
+}
+
+Context::~Context() {
+    Wait();
+}
+
+void Context::DecreaseTaskCount() {
+    if (m_taskCount.fetch_sub(1) == 1) {
+        NotifyWaiters();
+    }
+}
+
+bool JobHandle::IsDone() const {
+    return !m_batch || m_batch->done.load();
+}
+
+JobHandle Context::DispatchImpl(uint32_t p_job_count,
+                                uint32_t p_group_size,
+                                JobTask&& p_task,
+                                std::span<const JobHandle> p_dependencies) {
+    ERR_FAIL_COND_V(p_group_size == 0, JobHandle());
+    if (p_job_count == 0 && p_dependencies.empty()) {
+        return JobHandle();
     }
 
     const uint32_t group_count = (p_job_count + p_group_size - 1) / p_group_size;  // make sure round up
-    m_taskCount.fetch_add(group_count);
+    // one extra task for the batch, released once it completed
+    m_taskCount.fetch_add(group_count + 1);
 
+    Batch& batch = m_batches.emplace_back();
+    batch.ctx = this;
+    batch.priority = m_priority;
+    // all groups of a dispatch share the same task
+    batch.task = std::move(p_task);
+    batch.pendingGroups = group_count;
+    batch.jobs.resize(group_count);
     for (uint32_t group_id = 0; group_id < group_count; ++group_id) {
-        Job job;
-        job.ctx = this;
-        job.task = p_task;
+        Job& job = batch.jobs[group_id];
+        job.batch = &batch;
         job.groupId = group_id;
         job.groupJobOffset = group_id * p_group_size;
-        job.groupJobEnd = glm::min(job.groupJobOffset + p_group_size, p_job_count);
+        job.groupJobEnd = std::min(job.groupJobOffset + p_group_size, p_job_count);
+    }
 
-        while (!s_glob.jobQueue.push_back(job)) {
-            // if job queue is full, notify all and let main thread do the work as well
-            s_glob.wakeCondition.notify_all();
-            DoWork();
+    for (const JobHandle& dependency : p_dependencies) {
+        Batch* other = dependency.m_batch;
+        if (!other) {
+            continue;
+        }
+
+        std::lock_guard lock(other->lock);
+        if (!other->done.load()) {
+            batch.pendingDependencies.fetch_add(1);
+            other->continuations.push_back(&batch);
         }
     }
 
-    s_glob.wakeCondition.notify_all();
+    // drop the reference held while registering, schedule now unless a dependency is still running
+    if (batch.pendingDependencies.fetch_sub(1) == 1) {
+        ScheduleBatch(batch);
+    }
+
+    return JobHandle(&batch);
 }
 
 void Context::Wait() {
     HBN_PROFILE_EVENT();
 
-    // Wake any threads that might be sleeping:
-    s_glob.wakeCondition.notify_all();
+    // Waiting will also put the current thread to good use by working on an other job if it can
+    HelpUntil(GetHelpLimit(m_priority), [this]() { return !IsBusy(); });
 
-    // Waiting will also put the current thread to good use by working on an other job if it can:
-    while (IsBusy()) {
-        DoWork();
-    }
+    m_batches.clear();
+}
+
+void Context::Wait(const JobHandle& p_handle) {
+    HBN_PROFILE_EVENT();
+
+    const JobPriority limit = GetHelpLimit(p_handle.m_batch ? p_handle.m_batch->priority : m_priority);
+    HelpUntil(limit, [&p_handle]() { return p_handle.IsDone(); });
 }
 
 }  // namespace my::jobsystem
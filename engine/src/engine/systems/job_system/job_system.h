@@ -1,39 +1,160 @@
 #pragma once
+#include "engine/core/base/inplace_function.h"
 
 namespace my::jobsystem {
 
+enum JobPriority : uint8_t {
+    // frame work, the main thread is usually waiting on it
+    JOB_PRIORITY_CRITICAL,
+    JOB_PRIORITY_NORMAL,
+    // asset decoding, bvh builds, anything that can take longer than a frame. Only runs on workers no frame
+    // job needs, and never on a thread waiting for more urgent jobs.
+    JOB_PRIORITY_BACKGROUND,
+    JOB_PRIORITY_COUNT,
+};
+
 struct JobArgs {
     uint32_t jobIndex;
     uint32_t groupId;
     uint32_t groupIndex;
 };
 
+// Captures are stored inline in the batch, one per dispatch, bigger ones don't compile
+inline constexpr size_t JOB_TASK_CAPACITY = 64;
+using JobTask = InplaceFunction<void(JobArgs), JOB_TASK_CAPACITY>;
+
+class Context;
+struct Batch;
+
+struct Job {
+    Batch* batch;
+    uint32_t groupId;
+    uint32_t groupJobOffset;
+    uint32_t groupJobEnd;
+};
+
+// All the groups of one Dispatch(). The jobs are only pushed to the queues once every dependency has
+// completed, the last dependency to complete pushes them.
+struct Batch {
+    // null for RunAsync() batches, which free themselves once completed
+    Context* ctx;
+    JobPriority priority;
+    // shared by all the groups
+    JobTask task;
+    std::vector<Job> jobs;
+
+    // groups that haven't finished running
+    std::atomic_uint32_t pendingGroups = 0;
+    // dependencies that haven't completed, plus one held by Dispatch() while it registers them
+    std::atomic_uint32_t pendingDependencies = 1;
+
+    // guards continuations, done is only set while holding it, so a continuation is never registered too late
+    std::mutex lock;
+    std::atomic_bool done = false;
+    std::vector<Batch*> continuations;
+};
+
+// Refers to the jobs of one Dispatch(). A default constructed handle is always done. Handles stay
+// valid until Wait() is called on the context that created them.
+class JobHandle {
+public:
+    JobHandle() = default;
+
+    bool IsDone() const;
+
+private:
+    explicit JobHandle(Batch* p_batch) : m_batch(p_batch) {}
+
+    Batch* m_batch = nullptr;
+
+    friend class Context;
+};
+
+// A context tracks a batch of dispatched jobs. Dispatch() and Wait() on the same context
+// should be called from one thread at a time, jobs are free to dispatch to their own contexts.
+// Every job dispatched to a context has the context's priority.
 class Context {
 public:
-    void DecreaseTaskCount() { m_taskCount.fetch_sub(1); }
+    // inherits the priority of the job running on the calling thread, normal outside of jobs
+    Context();
+    explicit Context(JobPriority p_priority) : m_priority(p_priority) {}
+    ~Context();
+
+    Context(const Context&) = delete;
+    Context& operator=(const Context&) = delete;
+
+    void DecreaseTaskCount();
 
     bool IsBusy() const { return m_taskCount.load() > 0; }
 
-    void Dispatch(uint32_t p_job_count, uint32_t p_group_size, const std::function<void(JobArgs)>& p_task);
+    JobPriority GetPriority() const { return m_priority; }
+
+    // The jobs only start once all of p_dependencies are done, handles from other contexts are fine as
+    // long as they are still valid. Dispatching zero jobs gives a handle that completes together with
+    // p_dependencies, which can be used to join several handles into one.
+    template<typename FUNC>
+    JobHandle Dispatch(uint32_t p_job_count,
+                       uint32_t p_group_size,
+                       FUNC&& p_task,
+                       std::span<const JobHandle> p_dependencies = {}) {
+        return DispatchImpl(p_job_count, p_group_size, JobTask(std::forward<FUNC>(p_task)), p_dependencies);
+    }
 
+    // continuation, runs p_task after p_dependency is done
+    template<typename FUNC>
+    JobHandle Then(const JobHandle& p_dependency,
+                   uint32_t p_job_count,
+                   uint32_t p_group_size,
+                   FUNC&& p_task) {
+        return Dispatch(p_job_count, p_group_size, std::forward<FUNC>(p_task), std::span<const JobHandle>(&p_dependency, 1));
+    }
+
+    JobHandle WhenAll(std::span<const JobHandle> p_dependencies) {
+        return Dispatch(0, 1, nullptr, p_dependencies);
+    }
+
+    // waits for every job dispatched to this context, invalidates all the handles it created
     void Wait();
 
+    // waits for p_handle only, other jobs of the context keep running and the handles stay valid
+    void Wait(const JobHandle& p_handle);
+
 private:
+    JobHandle DispatchImpl(uint32_t p_job_count,
+                           uint32_t p_group_size,
+                           JobTask&& p_task,
+                           std::span<const JobHandle> p_dependencies);
+
+    const JobPriority m_priority;
     std::atomic_int m_taskCount = 0;
-};
 
-struct Job {
-    Context* ctx;
-    std::function<void(JobArgs)> task;
-    uint32_t groupId;
-    uint32_t groupJobOffset;
-    uint32_t groupJobEnd;
+    // keep batches alive until Wait(), deque doesn't invalidate references on push_back
+    std::deque<Batch> m_batches;
 };
 
-bool Initialize();
+// has to be called before the worker threads start, with the number of threads running WorkerMain()
+bool Initialize(uint32_t p_worker_count);
 
 void Finalize();
 
 void WorkerMain();
 
+// number of threads running WorkerMain(), 0 when jobs only run on the threads waiting for them
+uint32_t GetWorkerCount();
+
+// priority of the job running on the calling thread, normal outside of jobs
+JobPriority GetCurrentPriority();
+
+void RunAsyncImpl(JobPriority p_priority, JobTask&& p_task);
+
+// Runs queued jobs up to p_priority on the calling thread until p_done() returns true, for jobs no context waits
+// on, like the RunAsync() ones. The workers stop once shutdown is requested, this still drains the queues.
+void RunJobsUntil(JobPriority p_priority, const std::function<bool()>& p_done);
+
+// Fire and forget, for work nobody waits on, like loading an asset. The task runs as a single job.
+template<typename FUNC>
+void RunAsync(JobPriority p_priority, FUNC&& p_task) {
+    RunAsyncImpl(p_priority, JobTask([task = std::forward<FUNC>(p_task)](JobArgs) mutable { task(); }));
+}
+
 }  // namespace my::jobsystem
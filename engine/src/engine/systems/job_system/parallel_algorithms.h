@@ -0,0 +1,358 @@
+#pragma once
+#include <algorithm>
+#include <numeric>
+
+#include "job_system.h"
+
+namespace my::jobsystem {
+
+// Blocking parallel versions of the std algorithms. The range is cut into a few blocks per thread, the blocks
+// run as jobs of a context of their own and the call returns once everything is done, so they work from the
+// main thread and from inside jobs alike. p_grain is the smallest block worth a job, ranges that don't make two
+// blocks run inline. Algorithms that need a scratch buffer require default constructible values.
+inline constexpr size_t PARALLEL_DEFAULT_GRAIN = 4096;
+
+namespace detail {
+
+// leaves room to balance blocks that take longer than the others
+inline constexpr size_t BLOCKS_PER_THREAD = 4;
+
+// runs p_func(index) for every index in [0, p_count) and waits
+template<typename FUNC>
+void RunJobs(uint32_t p_count, const FUNC& p_func) {
+    if (p_count <= 1) {
+        if (p_count == 1) {
+            p_func(0u);
+        }
+        return;
+    }
+
+    Context ctx;
+    ctx.Dispatch(p_count, 1, [&p_func](JobArgs p_args) { p_func(p_args.jobIndex); });
+    ctx.Wait();
+}
+
+// Splits [0, p_count) into evenly sized blocks, every block has at least one item. The split only depends on
+// the count, so the passes of an algorithm agree on it.
+class Blocks {
+public:
+    Blocks(size_t p_count, size_t p_grain) : m_count(p_count) {
+        p_grain = std::max<size_t>(p_grain, 1);
+        const size_t max_blocks = (GetWorkerCount() + 1) * BLOCKS_PER_THREAD;
+        const size_t wanted = (p_count + p_grain - 1) / p_grain;
+        m_blockCount = static_cast<uint32_t>(std::clamp<size_t>(wanted, 1, max_blocks));
+    }
+
+    uint32_t GetCount() const { return m_blockCount; }
+
+    size_t GetBegin(uint32_t p_block) const { return m_count * p_block / m_blockCount; }
+
+    size_t GetEnd(uint32_t p_block) const { return m_count * (p_block + 1) / m_blockCount; }
+
+    // runs p_func(block, begin, end) for every block and waits
+    template<typename FUNC>
+    void Run(const FUNC& p_func) const {
+        RunJobs(m_blockCount, [this, &p_func](uint32_t p_block) {
+            p_func(p_block, GetBegin(p_block), GetEnd(p_block));
+        });
+    }
+
+private:
+    size_t m_count;
+    uint32_t m_blockCount;
+};
+
+// reduction of every block, blocks are never empty so no identity is needed
+template<typename IT, typename OP>
+std::vector<std::iter_value_t<IT>> ReduceBlocks(IT p_first, const Blocks& p_blocks, OP& p_op) {
+    std::vector<std::iter_value_t<IT>> sums(p_blocks.GetCount());
+    p_blocks.Run([&](uint32_t p_block, size_t p_begin, size_t p_end) {
+        sums[p_block] = std::accumulate(p_first + p_begin + 1, p_first + p_end, p_first[p_begin], p_op);
+    });
+    return sums;
+}
+
+// number of the first p_k outputs of a stable merge of a and b that come from a
+template<typename IT_A, typename IT_B, typename COMPARE>
+size_t MergeCoRank(IT_A p_a, size_t p_a_count, IT_B p_b, size_t p_b_count, size_t p_k, COMPARE& p_compare) {
+    size_t low = p_k > p_b_count ? p_k - p_b_count : 0;
+    size_t high = std::min(p_k, p_a_count);
+    while (low < high) {
+        const size_t i = low + (high - low) / 2;
+        // a[i] comes before b[k - i - 1] unless it is strictly less, ties go to a
+        if (!p_compare(p_b[p_k - i - 1], p_a[i])) {
+            low = i + 1;
+        } else {
+            high = i;
+        }
+    }
+    return low;
+}
+
+}  // namespace detail
+
+// p_op has to be associative, the blocks are combined in order so it doesn't need to be commutative
+template<std::random_access_iterator IT, typename T, typename OP = std::plus<>>
+T ParallelReduce(IT p_first, IT p_last, T p_init, OP p_op = {}, size_t p_grain = PARALLEL_DEFAULT_GRAIN) {
+    const detail::Blocks blocks(static_cast<size_t>(p_last - p_first), p_grain);
+    if (blocks.GetCount() == 1) {
+        return std::accumulate(p_first, p_last, std::move(p_init), p_op);
+    }
+
+    const auto sums = detail::ReduceBlocks(p_first, blocks, p_op);
+    return std::accumulate(sums.begin(), sums.end(), std::move(p_init), p_op);
+}
+
+// Every block is reduced, the block sums are scanned inline, then every block is scanned starting from its
+// carry. p_out can be p_first.
+template<std::random_access_iterator IT, std::random_access_iterator OUT, typename OP = std::plus<>>
+OUT ParallelInclusiveScan(IT p_first, IT p_last, OUT p_out, OP p_op = {}, size_t p_grain = PARALLEL_DEFAULT_GRAIN) {
+    const size_t count = static_cast<size_t>(p_last - p_first);
+    const detail::Blocks blocks(count, p_grain);
+    if (blocks.GetCount() == 1) {
+        return std::inclusive_scan(p_first, p_last, p_out, p_op);
+    }
+
+    auto carries = detail::ReduceBlocks(p_first, blocks, p_op);
+    // carries[i] becomes the sum of the blocks before block i + 1
+    for (uint32_t block = 1; block < blocks.GetCount(); ++block) {
+        carries[block] = p_op(carries[block - 1], carries[block]);
+    }
+
+    blocks.Run([&](uint32_t p_block, size_t p_begin, size_t p_end) {
+        if (p_block == 0) {
+            std::inclusive_scan(p_first + p_begin, p_first + p_end, p_out + p_begin, p_op);
+        } else {
+            std::inclusive_scan(p_first + p_begin, p_first + p_end, p_out + p_begin, p_op, carries[p_block - 1]);
+        }
+    });
+    return p_out + count;
+}
+
+// p_out can be p_first
+template<std::random_access_iterator IT, std::random_access_iterator OUT, typename T, typename OP = std::plus<>>
+OUT ParallelExclusiveScan(IT p_first,
+                          IT p_last,
+                          OUT p_out,
+                          T p_init,
+                          OP p_op = {},
+                          size_t p_grain = PARALLEL_DEFAULT_GRAIN) {
+    const size_t count = static_cast<size_t>(p_last - p_first);
+    const detail::Blocks blocks(count, p_grain);
+    if (blocks.GetCount() == 1) {
+        return std::exclusive_scan(p_first, p_last, p_out, std::move(p_init), p_op);
+    }
+
+    auto carries = detail::ReduceBlocks(p_first, blocks, p_op);
+    // shift right, carries[i] becomes p_init plus the blocks before block i
+    for (uint32_t block = 0; block < blocks.GetCount(); ++block) {
+        T sum = p_op(p_init, carries[block]);
+        carries[block] = std::move(p_init);
+        p_init = std::move(sum);
+    }
+
+    blocks.Run([&](uint32_t p_block, size_t p_begin, size_t p_end) {
+        std::exclusive_scan(p_first + p_begin, p_first + p_end, p_out + p_begin, carries[p_block], p_op);
+    });
+    return p_out + count;
+}
+
+// Like std::stable_partition, returns the first element for which p_predicate is false. p_predicate is called
+// once per element, the elements are moved through a scratch buffer.
+template<std::random_access_iterator IT, typename PRED>
+IT ParallelStablePartition(IT p_first, IT p_last, PRED p_predicate, size_t p_grain = PARALLEL_DEFAULT_GRAIN) {
+    const size_t count = static_cast<size_t>(p_last - p_first);
+    const detail::Blocks blocks(count, p_grain);
+    if (blocks.GetCount() == 1) {
+        return std::stable_partition(p_first, p_last, p_predicate);
+    }
+
+    std::vector<uint8_t> selected(count);
+    std::vector<size_t> offsets(blocks.GetCount());
+    blocks.Run([&](uint32_t p_block, size_t p_begin, size_t p_end) {
+        size_t selected_count = 0;
+        for (size_t i = p_begin; i < p_end; ++i) {
+            selected[i] = p_predicate(p_first[i]) ? 1 : 0;
+            selected_count += selected[i];
+        }
+        offsets[p_block] = selected_count;
+    });
+
+    const size_t selected_total = std::accumulate(offsets.begin(), offsets.end(), size_t(0));
+    // offsets[i] becomes where block i writes its first selected element
+    std::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), size_t(0));
+
+    std::vector<std::iter_value_t<IT>> scratch(count);
+    blocks.Run([&](uint32_t p_block, size_t p_begin, size_t p_end) {
+        size_t selected_index = offsets[p_block];
+        // the rejected elements before this block are the ones that weren't selected
+        size_t rejected_index = selected_total + p_begin - offsets[p_block];
+        for (size_t i = p_begin; i < p_end; ++i) {
+            scratch[selected[i] ? selected_index++ : rejected_index++] = std::move(p_first[i]);
+        }
+    });
+    blocks.Run([&](uint32_t, size_t p_begin, size_t p_end) {
+        std::move(scratch.begin() + p_begin, scratch.begin() + p_end, p_first + p_begin);
+    });
+    return p_first + selected_total;
+}
+
+// Stable. Every block is sorted on its own, then neighbouring runs are merged pairwise until one is left.
+// Each merge is cut into block sized pieces along the merge path, so the last merges use every thread too.
+template<std::random_access_iterator IT, typename COMPARE = std::less<>>
+void ParallelMergeSort(IT p_first, IT p_last, COMPARE p_compare = {}, size_t p_grain = PARALLEL_DEFAULT_GRAIN) {
+    const size_t count = static_cast<size_t>(p_last - p_first);
+    const detail::Blocks blocks(count, p_grain);
+    if (blocks.GetCount() == 1) {
+        std::stable_sort(p_first, p_last, p_compare);
+        return;
+    }
+
+    blocks.Run([&](uint32_t, size_t p_begin, size_t p_end) {
+        std::stable_sort(p_first + p_begin, p_first + p_end, p_compare);
+    });
+
+    // run boundaries, runs [bounds[i], bounds[i + 1])
+    std::vector<size_t> bounds(blocks.GetCount() + 1);
+    for (uint32_t block = 0; block < blocks.GetCount(); ++block) {
+        bounds[block] = blocks.GetBegin(block);
+    }
+    bounds.back() = count;
+
+    struct Piece {
+        size_t low;
+        size_t middle;
+        size_t high;
+        // output range, relative to low
+        size_t begin;
+        size_t end;
+    };
+
+    const size_t piece_size = (count + blocks.GetCount() - 1) / blocks.GetCount();
+    std::vector<std::iter_value_t<IT>> scratch(count);
+    std::vector<Piece> pieces;
+    std::vector<size_t> merged_bounds;
+    bool in_scratch = false;
+
+    auto merge = [&](auto p_source, auto p_dest) {
+        detail::RunJobs(static_cast<uint32_t>(pieces.size()), [&](uint32_t p_index) {
+            const Piece& piece = pieces[p_index];
+            const auto a = p_source + piece.low;
+            const auto b = p_source + piece.middle;
+            const size_t a_count = piece.middle - piece.low;
+            const size_t b_count = piece.high - piece.middle;
+            const size_t a_begin = detail::MergeCoRank(a, a_count, b, b_count, piece.begin, p_compare);
+            const size_t a_end = detail::MergeCoRank(a, a_count, b, b_count, piece.end, p_compare);
+            std::merge(std::make_move_iterator(a + a_begin),
+                       std::make_move_iterator(a + a_end),
+                       std::make_move_iterator(b + (piece.begin - a_begin)),
+                       std::make_move_iterator(b + (piece.end - a_end)),
+                       p_dest + piece.low + piece.begin,
+                       p_compare);
+        });
+    };
+
+    while (bounds.size() > 2) {
+        pieces.clear();
+        merged_bounds.clear();
+        for (size_t run = 0; run + 1 < bounds.size(); run += 2) {
+            const size_t low = bounds[run];
+            const size_t middle = bounds[run + 1];
+            // an odd run out is merged with nothing, which moves it over
+            const size_t high = run + 2 < bounds.size() ? bounds[run + 2] : middle;
+            merged_bounds.push_back(low);
+            for (size_t begin = 0; begin < high - low; begin += piece_size) {
+                pieces.push_back({ low, middle, high, begin, std::min(begin + piece_size, high - low) });
+            }
+        }
+        merged_bounds.push_back(count);
+        bounds.swap(merged_bounds);
+
+        if (in_scratch) {
+            merge(scratch.begin(), p_first);
+        } else {
+            merge(p_first, scratch.begin());
+        }
+        in_scratch = !in_scratch;
+    }
+
+    if (in_scratch) {
+        blocks.Run([&](uint32_t, size_t p_begin, size_t p_end) {
+            std::move(scratch.begin() + p_begin, scratch.begin() + p_end, p_first + p_begin);
+        });
+    }
+}
+
+// Stable least significant digit radix sort on the unsigned integer p_key returns, one byte per pass. Bytes all
+// the keys share are skipped, so small keys in wide integers only cost the passes they need.
+template<std::random_access_iterator IT, typename KEY = std::identity>
+void ParallelRadixSort(IT p_first, IT p_last, KEY p_key = {}, size_t p_grain = PARALLEL_DEFAULT_GRAIN) {
+    using T = std::iter_value_t<IT>;
+    using Key = std::decay_t<std::invoke_result_t<KEY&, const T&>>;
+    static_assert(std::is_unsigned_v<Key>, "radix sort keys have to be unsigned integers");
+
+    constexpr uint32_t RADIX_BITS = 8;
+    constexpr size_t BUCKET_COUNT = 1 << RADIX_BITS;
+
+    const size_t count = static_cast<size_t>(p_last - p_first);
+    if (count < 2) {
+        return;
+    }
+
+    const detail::Blocks blocks(count, p_grain);
+    // per block, the count of every digit, then where the block writes it
+    std::vector<std::array<size_t, BUCKET_COUNT>> histograms(blocks.GetCount());
+    std::vector<T> scratch(count);
+    bool in_scratch = false;
+
+    auto pass = [&](auto p_source, auto p_dest, uint32_t p_shift) {
+        auto digit = [&](const T& p_value) {
+            return static_cast<size_t>((p_key(p_value) >> p_shift) & (BUCKET_COUNT - 1));
+        };
+
+        blocks.Run([&](uint32_t p_block, size_t p_begin, size_t p_end) {
+            auto& histogram = histograms[p_block];
+            histogram.fill(0);
+            for (size_t i = p_begin; i < p_end; ++i) {
+                ++histogram[digit(p_source[i])];
+            }
+        });
+
+        size_t offset = 0;
+        for (size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+            const size_t bucket_begin = offset;
+            for (auto& histogram : histograms) {
+                const size_t digit_count = histogram[bucket];
+                histogram[bucket] = offset;
+                offset += digit_count;
+            }
+            if (offset - bucket_begin == count) {
+                // every key has this digit, the pass wouldn't change the order
+                return false;
+            }
+        }
+
+        blocks.Run([&](uint32_t p_block, size_t p_begin, size_t p_end) {
+            auto& histogram = histograms[p_block];
+            for (size_t i = p_begin; i < p_end; ++i) {
+                p_dest[histogram[digit(p_source[i])]++] = std::move(p_source[i]);
+            }
+        });
+        return true;
+    };
+
+    for (uint32_t shift = 0; shift < sizeof(Key) * 8; shift += RADIX_BITS) {
+        const bool moved = in_scratch ? pass(scratch.begin(), p_first, shift) : pass(p_first, scratch.begin(), shift);
+        if (moved) {
+            in_scratch = !in_scratch;
+        }
+    }
+
+    if (in_scratch) {
+        blocks.Run([&](uint32_t, size_t p_begin, size_t p_end) {
+            std::move(scratch.begin() + p_begin, scratch.begin() + p_end, p_first + p_begin);
+        });
+    }
+}
+
+}  // namespace my::jobsystem
@@ -0,0 +1,57 @@
+#pragma once
+#include "job_system.h"
+
+namespace my::jobsystem {
+
+// Calls p_body(index) for every index in [0, p_count) once p_dependency is done. The chunk sizes are picked
+// at run time with guided self-scheduling: one job per thread that can help, each repeatedly claims
+// remaining / (2 * job count) items from a shared cursor. Chunks start big and shrink towards the end, so a
+// huge range costs a handful of atomics per job, while a few expensive items still spread over every worker.
+// p_grain is the smallest chunk worth claiming. Like every job, p_body runs after the caller returned and
+// must not capture locals by reference unless the caller waits.
+template<typename FUNC>
+JobHandle ParallelFor(Context& p_context,
+                      const JobHandle& p_dependency,
+                      uint32_t p_count,
+                      FUNC&& p_body,
+                      uint32_t p_grain = 1) {
+    if (p_count == 0) {
+        return p_dependency;
+    }
+
+    p_grain = std::max(p_grain, 1u);
+    const uint32_t chunk_count = (p_count + p_grain - 1) / p_grain;
+    // the waiting thread helps too
+    const uint32_t job_count = std::min(GetWorkerCount() + 1, chunk_count);
+
+    // only copied into the batch before any job runs, after that every job shares the one in the task
+    struct Cursor {
+        Cursor() = default;
+        Cursor(Cursor&& p_other) noexcept : next(p_other.next.load(std::memory_order_relaxed)) {}
+
+        std::atomic_uint32_t next = 0;
+    };
+
+    auto task = [cursor = Cursor(), body = std::forward<FUNC>(p_body), p_count, p_grain, job_count](JobArgs) mutable {
+        uint32_t begin = cursor.next.load(std::memory_order_relaxed);
+        for (;;) {
+            uint32_t end;
+            do {
+                if (begin >= p_count) {
+                    return;
+                }
+                const uint32_t chunk = std::max((p_count - begin) / (2 * job_count), p_grain);
+                end = std::min(begin + chunk, p_count);
+            } while (!cursor.next.compare_exchange_weak(begin, end, std::memory_order_relaxed));
+
+            for (uint32_t index = begin; index < end; ++index) {
+                body(index);
+            }
+            begin = end;
+        }
+    };
+
+    return p_context.Then(p_dependency, job_count, 1, std::move(task));
+}
+
+}  // namespace my::jobsystem
@@ -0,0 +1,11 @@
+#include "scratch_allocator.h"
+
+namespace my::jobsystem {
+
+LinearArena& GetScratchArena() {
+    // created on first use by each thread and released when it exits
+    static thread_local LinearArena s_arena(SCRATCH_BLOCK_SIZE, memory::MEMORY_TAG_SCRATCH);
+    return s_arena;
+}
+
+}  // namespace my::jobsystem
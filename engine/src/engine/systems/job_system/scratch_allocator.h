@@ -0,0 +1,36 @@
+#pragma once
+#include "engine/core/base/linear_arena.h"
+
+namespace my::jobsystem {
+
+inline constexpr size_t SCRATCH_BLOCK_SIZE = 256 * 1024;
+
+// Temporary memory of the calling thread. Every job worker, the main thread included, has its own arena, so
+// job bodies can allocate without going through the global heap lock. Only use it through a ScratchScope.
+LinearArena& GetScratchArena();
+
+// Gives back everything allocated from the thread's scratch arena while it was alive. Scopes nest, a job
+// waiting inside a scope can run other jobs on the same thread, each with its own scope on top.
+// Containers of an outer scope must not grow while an inner one is open, and nothing allocated in a scope
+// may be handed to another thread that outlives it.
+class ScratchScope : public NonCopyable {
+public:
+    ScratchScope() : m_arena(GetScratchArena()), m_marker(m_arena.GetMarker()) {}
+
+    ~ScratchScope() { m_arena.Rewind(m_marker); }
+
+    // e.g. ScratchVector<int> values(scope.GetArena());
+    LinearArena& GetArena() const { return m_arena; }
+
+private:
+    LinearArena& m_arena;
+    const LinearArena::Marker m_marker;
+};
+
+template<typename T>
+using ScratchAllocator = ArenaAllocator<T>;
+
+template<typename T>
+using ScratchVector = ArenaVector<T>;
+
+}  // namespace my::jobsystem
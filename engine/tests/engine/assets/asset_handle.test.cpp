@@ -0,0 +1,15 @@
+#include "engine/assets/asset_handle.h"
+
+namespace my {
+
+TEST(asset_handle, string_id_matches_path) {
+    static constexpr StringId s_path("@res://images/brdf.hdr");
+    const AssetHandle from_id{ s_path };
+    const AssetHandle from_path{ std::string("@res://images/brdf.hdr") };
+
+    EXPECT_EQ(from_id.hash, from_path.hash);
+    EXPECT_EQ(std::hash<AssetHandle>{}(from_id), std::hash<AssetHandle>{}(from_path));
+    EXPECT_NE(AssetHandle{ StringId("@res://images/brdf2.hdr") }.hash, from_path.hash);
+}
+
+}  // namespace my
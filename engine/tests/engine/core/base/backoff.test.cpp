@@ -0,0 +1,39 @@
+#include "engine/core/base/backoff.h"
+
+namespace my {
+
+TEST(backoff, gives_up) {
+    Backoff backoff;
+    int steps = 0;
+    while (backoff.Pause()) {
+        ++steps;
+    }
+    EXPECT_EQ(steps, Backoff::SPIN_STEPS + Backoff::YIELD_STEPS);
+    EXPECT_FALSE(backoff.Pause());
+
+    backoff.Reset();
+    EXPECT_TRUE(backoff.Pause());
+}
+
+TEST(backoff, wait_until_done) {
+    std::atomic_int value = 3;
+    EXPECT_EQ(WaitUntil(value, [](int p_value) { return p_value == 3; }), 3);
+}
+
+TEST(backoff, wait_until_notified) {
+    std::atomic_int value = 0;
+
+    std::thread thread([&value]() {
+        // long enough for the waiter to park
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        for (int i = 0; i < 4; ++i) {
+            value.fetch_add(1);
+            value.notify_all();
+        }
+    });
+
+    EXPECT_EQ(WaitUntil(value, [](int p_value) { return p_value == 4; }), 4);
+    thread.join();
+}
+
+}  // namespace my
@@ -22,15 +22,18 @@ TEST(concurrent_queue, test) {
     latch.wait();
     std::string buffer;
     for (;;) {
-        if (task_count <= 0) {
-            break;
-        }
+        // check before popping, the last values can be pushed right after an empty pop_all()
+        const bool done = task_count <= 0;
 
         auto tasks = concurrent_queue.pop_all();
         while (!tasks.empty()) {
             buffer.push_back('A' + (char)tasks.front());
             tasks.pop();
         }
+
+        if (done) {
+            break;
+        }
     }
 
     worker.join();
@@ -42,4 +45,79 @@ TEST(concurrent_queue, test) {
               "ABCDEFGHIJKLMNOPQRSTUVWXYZ");
 }
 
+TEST(concurrent_queue, push_pop) {
+    // spans a few segments
+    constexpr int COUNT = 1000;
+    ConcurrentQueue<std::string> queue;
+    std::string value;
+    EXPECT_FALSE(queue.pop(value));
+
+    for (int i = 0; i < COUNT; ++i) {
+        queue.push(std::to_string(i));
+    }
+    for (int i = 0; i < COUNT / 2; ++i) {
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, std::to_string(i));
+    }
+
+    auto rest = queue.pop_all();
+    ASSERT_EQ(rest.size(), COUNT / 2);
+    for (int i = COUNT / 2; i < COUNT; ++i) {
+        EXPECT_EQ(rest.front(), std::to_string(i));
+        rest.pop();
+    }
+
+    EXPECT_FALSE(queue.pop(value));
+    EXPECT_TRUE(queue.pop_all().empty());
+
+    // the queue keeps working once it's been drained
+    queue.push("again");
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, "again");
+}
+
+TEST(concurrent_queue, concurrent) {
+    constexpr int PRODUCER_COUNT = 4;
+    constexpr int CONSUMER_COUNT = 4;
+    constexpr int ITEM_COUNT = 50000;
+    ConcurrentQueue<int> queue;
+    std::vector<std::atomic_int> visited(PRODUCER_COUNT * ITEM_COUNT);
+    std::atomic_int consumed = 0;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < CONSUMER_COUNT; ++i) {
+        threads.emplace_back([&, i]() {
+            while (consumed.load() < PRODUCER_COUNT * ITEM_COUNT) {
+                // half of the consumers take values one by one, the other half in batches
+                if (i % 2) {
+                    auto values = queue.pop_all();
+                    consumed.fetch_add(static_cast<int>(values.size()));
+                    for (; !values.empty(); values.pop()) {
+                        visited[values.front()].fetch_add(1);
+                    }
+                } else if (int value; queue.pop(value)) {
+                    visited[value].fetch_add(1);
+                    consumed.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (int i = 0; i < PRODUCER_COUNT; ++i) {
+        threads.emplace_back([&, i]() {
+            for (int j = 0; j < ITEM_COUNT; ++j) {
+                queue.push(i * ITEM_COUNT + j);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(consumed.load(), PRODUCER_COUNT * ITEM_COUNT);
+    for (const auto& count : visited) {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
 }  // namespace my
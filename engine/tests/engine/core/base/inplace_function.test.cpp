@@ -0,0 +1,73 @@
+#include "engine/core/base/inplace_function.h"
+
+namespace my {
+
+TEST(inplace_function, call) {
+    InplaceFunction<int(int, int), 16> func = [](int p_a, int p_b) { return p_a + p_b; };
+    EXPECT_TRUE(func);
+    EXPECT_EQ(func(1, 2), 3);
+
+    int base = 10;
+    func = [&base](int p_a, int p_b) { return base + p_a * p_b; };
+    EXPECT_EQ(func(2, 3), 16);
+
+    func = nullptr;
+    EXPECT_FALSE(func);
+}
+
+TEST(inplace_function, empty) {
+    InplaceFunction<void(), 16> func;
+    EXPECT_FALSE(func);
+
+    InplaceFunction<void(), 16> other(nullptr);
+    EXPECT_FALSE(other);
+}
+
+TEST(inplace_function, mutable_state) {
+    InplaceFunction<int(), 16> counter = [count = 0]() mutable { return ++count; };
+    EXPECT_EQ(counter(), 1);
+    EXPECT_EQ(counter(), 2);
+
+    InplaceFunction<int(), 16> moved = std::move(counter);
+    EXPECT_FALSE(counter);
+    EXPECT_EQ(moved(), 3);
+}
+
+TEST(inplace_function, lifetime) {
+    auto shared = std::make_shared<int>(42);
+    {
+        InplaceFunction<int(), 32> func = [shared]() { return *shared; };
+        EXPECT_EQ(shared.use_count(), 2);
+
+        InplaceFunction<int(), 32> moved;
+        moved = std::move(func);
+        EXPECT_EQ(shared.use_count(), 2);
+        EXPECT_EQ(moved(), 42);
+
+        moved = [] { return 0; };
+        EXPECT_EQ(shared.use_count(), 1);
+
+        moved = [shared]() { return *shared + 1; };
+        EXPECT_EQ(shared.use_count(), 2);
+    }
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(inplace_function, move_only_capture) {
+    auto value = std::make_unique<int>(7);
+    InplaceFunction<int(), 16> func = [value = std::move(value)]() { return *value; };
+    EXPECT_EQ(func(), 7);
+}
+
+TEST(inplace_function, capacity) {
+    struct Big {
+        char data[65];
+        void operator()() const {}
+    };
+
+    static_assert(std::is_constructible_v<InplaceFunction<void(), 64>, void (*)()>);
+    static_assert(InplaceFunction<void(), 64>::capacity() == 64);
+    static_assert(sizeof(Big) > InplaceFunction<void(), 64>::capacity());
+}
+
+}  // namespace my
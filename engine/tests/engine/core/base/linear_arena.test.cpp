@@ -0,0 +1,89 @@
+#include "engine/core/base/linear_arena.h"
+
+namespace my {
+
+TEST(linear_arena, alignment) {
+    LinearArena arena(256);
+    arena.Allocate(1, 1);
+    void* ptr = arena.Allocate(16, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % 64, 0u);
+    double* value = arena.New<double>(1.5);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(value) % alignof(double), 0u);
+    EXPECT_EQ(*value, 1.5);
+}
+
+TEST(linear_arena, grow) {
+    LinearArena arena(256);
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_NE(arena.Allocate(100), nullptr);
+    }
+    EXPECT_GE(arena.GetUsedSize(), 1600u);
+    EXPECT_GT(arena.GetCapacity(), 256u);
+
+    // bigger than a block
+    uint8_t* large = arena.AllocateArray<uint8_t>(1000);
+    memset(large, 0xFF, 1000);
+    EXPECT_GE(arena.GetUsedSize(), 2600u);
+}
+
+TEST(linear_arena, reset_reuses_memory) {
+    LinearArena arena(256);
+    void* first = arena.Allocate(64);
+    for (int i = 0; i < 8; ++i) {
+        arena.Allocate(200);
+    }
+    const size_t capacity = arena.GetCapacity();
+
+    arena.Reset();
+    EXPECT_EQ(arena.GetUsedSize(), 0u);
+    EXPECT_EQ(arena.Allocate(64), first);
+
+    for (int round = 0; round < 4; ++round) {
+        arena.Reset();
+        for (int i = 0; i < 8; ++i) {
+            arena.Allocate(200);
+        }
+        EXPECT_EQ(arena.GetCapacity(), capacity);
+    }
+}
+
+TEST(linear_arena, rewind) {
+    LinearArena arena(256);
+    const LinearArena::Marker empty = arena.GetMarker();
+    arena.Allocate(64);
+
+    const LinearArena::Marker marker = arena.GetMarker();
+    const size_t used = arena.GetUsedSize();
+    void* next = arena.Allocate(32);
+    // spills into new blocks
+    for (int i = 0; i < 8; ++i) {
+        arena.Allocate(200);
+    }
+
+    arena.Rewind(marker);
+    EXPECT_EQ(arena.GetUsedSize(), used);
+    EXPECT_EQ(arena.Allocate(32), next);
+
+    arena.Rewind(empty);
+    EXPECT_EQ(arena.GetUsedSize(), 0u);
+}
+
+TEST(linear_arena, containers) {
+    LinearArena arena(1024);
+    ArenaVector<int> vector(arena);
+    for (int i = 0; i < 1000; ++i) {
+        vector.push_back(i);
+    }
+    EXPECT_EQ(vector.size(), 1000u);
+    EXPECT_EQ(vector[999], 999);
+
+    ArenaUnorderedMap<int, int> map(arena);
+    for (int i = 0; i < 100; ++i) {
+        map[i] = i * 2;
+    }
+    EXPECT_EQ(map.size(), 100u);
+    EXPECT_EQ(map.at(42), 84);
+    EXPECT_EQ(map.find(100), map.end());
+}
+
+}  // namespace my
@@ -0,0 +1,93 @@
+#include "engine/core/base/mpmc_ring_buffer.h"
+
+namespace my {
+
+TEST(mpmc_ring_buffer, push_pop) {
+    MpmcRingBuffer<int, 4> queue;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.capacity(), 4);
+
+    int value = 0;
+    EXPECT_FALSE(queue.pop_front(value));
+
+    EXPECT_TRUE(queue.push_back(1));
+    EXPECT_TRUE(queue.push_back(2));
+    EXPECT_TRUE(queue.push_back(3));
+    EXPECT_TRUE(queue.push_back(4));
+    EXPECT_FALSE(queue.push_back(5));
+    EXPECT_EQ(queue.size(), 4);
+
+    for (int i = 1; i <= 4; ++i) {
+        EXPECT_TRUE(queue.pop_front(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.pop_front(value));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(mpmc_ring_buffer, wrap_around) {
+    MpmcRingBuffer<std::string, 2> queue;
+    std::string value;
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(queue.push_back(std::to_string(i)));
+        EXPECT_TRUE(queue.push_back(std::to_string(i + 100)));
+        EXPECT_FALSE(queue.push_back("full"));
+        EXPECT_TRUE(queue.pop_front(value));
+        EXPECT_EQ(value, std::to_string(i));
+        EXPECT_TRUE(queue.pop_front(value));
+        EXPECT_EQ(value, std::to_string(i + 100));
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(mpmc_ring_buffer, concurrent) {
+    constexpr int PRODUCER_COUNT = 4;
+    constexpr int CONSUMER_COUNT = 4;
+    constexpr int ITEM_COUNT = 50000;
+    MpmcRingBuffer<int, 256> queue;
+    std::vector<std::atomic_int> visited(PRODUCER_COUNT * ITEM_COUNT);
+    std::atomic_int consumed = 0;
+    std::atomic_int out_of_order = 0;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < CONSUMER_COUNT; ++i) {
+        threads.emplace_back([&]() {
+            // values of one producer have to come out in the order they went in
+            std::array<int, PRODUCER_COUNT> last;
+            last.fill(-1);
+            while (consumed.load() < PRODUCER_COUNT * ITEM_COUNT) {
+                int value;
+                if (queue.pop_front(value)) {
+                    const int producer = value / ITEM_COUNT;
+                    if (value <= last[producer]) {
+                        out_of_order.fetch_add(1);
+                    }
+                    last[producer] = value;
+                    visited[value].fetch_add(1);
+                    consumed.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (int i = 0; i < PRODUCER_COUNT; ++i) {
+        threads.emplace_back([&, i]() {
+            for (int j = 0; j < ITEM_COUNT; ++j) {
+                while (!queue.push_back(i * ITEM_COUNT + j)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(out_of_order.load(), 0);
+    EXPECT_TRUE(queue.empty());
+    for (const auto& count : visited) {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
+}  // namespace my
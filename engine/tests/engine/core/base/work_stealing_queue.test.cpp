@@ -0,0 +1,86 @@
+#include "engine/core/base/work_stealing_queue.h"
+
+namespace my {
+
+TEST(work_stealing_queue, push_pop) {
+    WorkStealingQueue<int, 4> queue;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+    EXPECT_TRUE(queue.push(3));
+    EXPECT_TRUE(queue.push(4));
+    EXPECT_FALSE(queue.push(5));
+    EXPECT_EQ(queue.size(), 4);
+
+    int value = 0;
+    // owner pops LIFO
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 4);
+    // thief steals FIFO
+    EXPECT_TRUE(queue.steal(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_FALSE(queue.pop(value));
+    EXPECT_FALSE(queue.steal(value));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(work_stealing_queue, wrap_around) {
+    WorkStealingQueue<int, 2> queue;
+    int value = 0;
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(queue.push(i));
+        EXPECT_TRUE(queue.steal(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(work_stealing_queue, concurrent_steal) {
+    constexpr int ITEM_COUNT = 100000;
+    constexpr int THIEF_COUNT = 3;
+    WorkStealingQueue<int, 1024> queue;
+    std::vector<std::atomic_int> visited(ITEM_COUNT);
+    std::atomic_int consumed = 0;
+
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < THIEF_COUNT; ++i) {
+        thieves.emplace_back([&]() {
+            while (consumed.load() < ITEM_COUNT) {
+                int value;
+                if (queue.steal(value)) {
+                    visited[value].fetch_add(1);
+                    consumed.fetch_add(1);
+                }
+            }
+        });
+    }
+
+    int value;
+    for (int i = 0; i < ITEM_COUNT; ++i) {
+        while (!queue.push(i)) {
+            if (queue.pop(value)) {
+                visited[value].fetch_add(1);
+                consumed.fetch_add(1);
+            }
+        }
+    }
+    while (queue.pop(value)) {
+        visited[value].fetch_add(1);
+        consumed.fetch_add(1);
+    }
+
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    EXPECT_EQ(consumed.load(), ITEM_COUNT);
+    for (int i = 0; i < ITEM_COUNT; ++i) {
+        EXPECT_EQ(visited[i].load(), 1);
+    }
+}
+
+}  // namespace my
@@ -0,0 +1,91 @@
+#include "engine/core/debugger/memory_tracker.h"
+
+namespace my::memory {
+
+TEST(memory_tracker, track) {
+    const MemoryStats before = GetStats(MEMORY_TAG_SCRIPT);
+
+    TrackAllocation(MEMORY_TAG_SCRIPT, PUBLISH_THRESHOLD);
+    MemoryStats stats = GetStats(MEMORY_TAG_SCRIPT);
+    EXPECT_EQ(stats.currentBytes - before.currentBytes, PUBLISH_THRESHOLD);
+    EXPECT_GE(stats.peakBytes, stats.currentBytes);
+    EXPECT_EQ(stats.allocationCount - before.allocationCount, 1u);
+
+    TrackDeallocation(MEMORY_TAG_SCRIPT, PUBLISH_THRESHOLD);
+    stats = GetStats(MEMORY_TAG_SCRIPT);
+    EXPECT_EQ(stats.currentBytes, before.currentBytes);
+    EXPECT_GE(stats.peakBytes, before.currentBytes + PUBLISH_THRESHOLD);
+}
+
+TEST(memory_tracker, tagged_vector) {
+    const int64_t before = GetStats(MEMORY_TAG_PHYSICS).currentBytes;
+    {
+        TaggedVector<uint8_t, MEMORY_TAG_PHYSICS> buffer(PUBLISH_THRESHOLD * 2);
+        EXPECT_EQ(GetStats(MEMORY_TAG_PHYSICS).currentBytes - before, PUBLISH_THRESHOLD * 2);
+    }
+    EXPECT_EQ(GetStats(MEMORY_TAG_PHYSICS).currentBytes, before);
+}
+
+TEST(memory_tracker, published_on_thread_exit) {
+    const MemoryStats before = GetStats(MEMORY_TAG_SCRIPT);
+    std::thread thread([]() {
+        // small enough to stay in the counters of the thread
+        TrackAllocation(MEMORY_TAG_SCRIPT, 100);
+        TrackAllocation(MEMORY_TAG_SCRIPT, 100);
+    });
+    thread.join();
+
+    const MemoryStats stats = GetStats(MEMORY_TAG_SCRIPT);
+    EXPECT_EQ(stats.currentBytes - before.currentBytes, 200);
+    EXPECT_EQ(stats.allocationCount - before.allocationCount, 2u);
+
+    // same way back, so nothing is left pending on this thread
+    std::thread([]() { TrackDeallocation(MEMORY_TAG_SCRIPT, 200); }).join();
+    EXPECT_EQ(GetStats(MEMORY_TAG_SCRIPT).currentBytes, before.currentBytes);
+}
+
+TEST(memory_tracker, tracked_after_thread_exit) {
+    struct Holder {
+        ~Holder() { TrackDeallocation(MEMORY_TAG_SCRIPT, 100); }
+    };
+
+    const int64_t before = GetStats(MEMORY_TAG_SCRIPT).currentBytes;
+    std::thread([]() {
+        // constructed before the counters of the thread are, so destroyed after they were published
+        static thread_local Holder s_holder;
+        (void)s_holder;
+        TrackAllocation(MEMORY_TAG_SCRIPT, 100);
+    }).join();
+
+    EXPECT_EQ(GetStats(MEMORY_TAG_SCRIPT).currentBytes, before);
+}
+
+TEST(memory_tracker, budget) {
+    const int64_t base = GetStats(MEMORY_TAG_PHYSICS).currentBytes;
+    SetBudget(MEMORY_TAG_PHYSICS, base + PUBLISH_THRESHOLD * 2);
+
+    TrackAllocation(MEMORY_TAG_PHYSICS, PUBLISH_THRESHOLD);
+    EXPECT_FALSE(GetStats(MEMORY_TAG_PHYSICS).overBudget);
+    TrackAllocation(MEMORY_TAG_PHYSICS, PUBLISH_THRESHOLD * 2);
+    EXPECT_TRUE(GetStats(MEMORY_TAG_PHYSICS).overBudget);
+
+    TrackDeallocation(MEMORY_TAG_PHYSICS, PUBLISH_THRESHOLD * 3);
+    // checked again once the counters are published
+    TrackAllocation(MEMORY_TAG_PHYSICS, PUBLISH_THRESHOLD);
+    EXPECT_FALSE(GetStats(MEMORY_TAG_PHYSICS).overBudget);
+    TrackDeallocation(MEMORY_TAG_PHYSICS, PUBLISH_THRESHOLD);
+
+    SetBudget(MEMORY_TAG_PHYSICS, 0);
+}
+
+TEST(memory_tracker, tagged_memory_resource) {
+    const int64_t before = GetStats(MEMORY_TAG_SCRIPT).currentBytes;
+    TaggedMemoryResource resource(MEMORY_TAG_SCRIPT);
+    {
+        std::pmr::vector<uint8_t> buffer(PUBLISH_THRESHOLD, &resource);
+        EXPECT_EQ(GetStats(MEMORY_TAG_SCRIPT).currentBytes - before, PUBLISH_THRESHOLD);
+    }
+    EXPECT_EQ(GetStats(MEMORY_TAG_SCRIPT).currentBytes, before);
+}
+
+}  // namespace my::memory
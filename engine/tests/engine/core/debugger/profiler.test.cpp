@@ -0,0 +1,93 @@
+#include "engine/core/debugger/profiler.h"
+
+#if USING(USE_NATIVE_PROFILER)
+#include "engine/core/io/file_access_unix.h"
+
+namespace my::profiler {
+
+static std::string ReadTrace(const std::string& p_path) {
+    auto file = FileAccess::Open(p_path, FileAccess::READ).value();
+    std::string buffer(file->GetLength(), '\0');
+    file->ReadBuffer(buffer.data(), buffer.length());
+    return buffer;
+}
+
+static size_t CountOccurrences(std::string_view p_string, std::string_view p_pattern) {
+    size_t count = 0;
+    for (size_t pos = p_string.find(p_pattern); pos != std::string_view::npos; pos = p_string.find(p_pattern, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+TEST(profiler, write_while_capturing) {
+    EXPECT_FALSE(IsCapturing());
+    BeginCapture();
+    EXPECT_TRUE(IsCapturing());
+    auto err = WriteChromeTrace("profiler_write_while_capturing.json").error();
+    EXPECT_EQ(err->value, ErrorCode::ERR_BUSY);
+    EndCapture();
+}
+
+TEST(profiler, capture) {
+    FileAccess::MakeDefault<FileAccessUnix>(FileAccess::ACCESS_FILESYSTEM);
+    const std::string FILE_NAME = "profiler_capture.json";
+
+    {
+        HBN_PROFILE_EVENT("profiler_before_capture");
+    }
+
+    BeginCapture();
+    std::thread worker([]() {
+        HBN_PROFILE_THREAD("profiler_worker");
+        HBN_PROFILE_EVENT("profiler_worker_event");
+    });
+    {
+        HBN_PROFILE_EVENT("profiler_outer");
+        HBN_PROFILE_EVENT("profiler_\"inner\"");
+    }
+    worker.join();
+    EndCapture();
+
+    {
+        HBN_PROFILE_EVENT("profiler_after_capture");
+    }
+
+    ASSERT_TRUE(WriteChromeTrace(FILE_NAME));
+    const std::string trace = ReadTrace(FILE_NAME);
+
+    EXPECT_EQ(CountOccurrences(trace, "\"ph\":\"X\""), 3);
+    EXPECT_NE(trace.find("\"name\":\"profiler_outer\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"profiler_\\\"inner\\\"\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"profiler_worker_event\""), std::string::npos);
+    EXPECT_NE(trace.find("\"args\":{\"name\":\"profiler_worker\"}"), std::string::npos);
+    EXPECT_EQ(trace.find("profiler_before_capture"), std::string::npos);
+    EXPECT_EQ(trace.find("profiler_after_capture"), std::string::npos);
+
+    ASSERT_TRUE(std::filesystem::remove(FILE_NAME));
+}
+
+TEST(profiler, frame_window) {
+    FileAccess::MakeDefault<FileAccessUnix>(FileAccess::ACCESS_FILESYSTEM);
+    const std::string FILE_NAME = "profiler_frame_window.json";
+
+    // starts at the end of the 2nd frame, stops at the end of the 5th
+    RequestCapture(1, 3, FILE_NAME);
+    for (int frame = 0; frame < 8; ++frame) {
+        EXPECT_EQ(IsCapturing(), frame >= 2 && frame < 5) << "frame " << frame;
+        {
+            HBN_PROFILE_EVENT("profiler_frame_event");
+        }
+        HBN_PROFILE_FRAME("MainThread");
+    }
+    EXPECT_FALSE(IsCapturing());
+
+    const std::string trace = ReadTrace(FILE_NAME);
+    EXPECT_EQ(CountOccurrences(trace, "\"name\":\"profiler_frame_event\""), 3);
+    EXPECT_EQ(CountOccurrences(trace, "\"name\":\"Frame\""), 3);
+
+    ASSERT_TRUE(std::filesystem::remove(FILE_NAME));
+}
+
+}  // namespace my::profiler
+#endif
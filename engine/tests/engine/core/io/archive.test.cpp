@@ -75,4 +75,52 @@ TEST(archive, write_and_read) {
     EXPECT_TRUE(std::filesystem::remove(test_file));
 }
 
+TEST(archive, read_mapped) {
+    const char* test_file = "archive_test_read_mapped";
+    const std::string test_string = "add3to2";
+    const std::vector<uint32_t> test_indices = { 0, 1, 2, 2, 1, 3 };
+    const std::vector<float> test_floats = { 1.0f, 2.0f, 3.0f };
+
+    Archive writer;
+    EXPECT_TRUE(writer.OpenWrite(test_file));
+    writer << test_string;
+    writer << test_indices;
+    writer << uint8_t(7);
+    writer << test_floats;
+    writer.Close();
+
+    Archive reader;
+    ASSERT_TRUE(reader.OpenReadMapped(test_file));
+    EXPECT_TRUE(reader.IsReadMode());
+    EXPECT_TRUE(reader.IsMapped());
+
+    std::string actual_string;
+    reader >> actual_string;
+    EXPECT_EQ(actual_string, test_string);
+
+    // string is 8 + 7 bytes, so the index data isn't aligned, and the span can't be used
+    std::span<const uint32_t> span;
+    EXPECT_FALSE(reader.ReadSpan(span));
+
+    std::vector<uint32_t> actual_indices;
+    reader >> actual_indices;
+    EXPECT_EQ(actual_indices, test_indices);
+
+    uint8_t actual_byte = 0;
+    reader >> actual_byte;
+    EXPECT_EQ(actual_byte, 7);
+
+    // 15 + 8 + 24 + 1 bytes, aligned to 4 bytes after the size
+    std::span<const float> floats;
+    ASSERT_TRUE(reader.ReadSpan(floats));
+    EXPECT_TRUE(std::equal(floats.begin(), floats.end(), test_floats.begin(), test_floats.end()));
+
+    // nothing left
+    EXPECT_TRUE(reader.ReadBytes(1).empty());
+    EXPECT_FALSE(reader.Read(actual_byte));
+
+    reader.Close();
+    EXPECT_TRUE(std::filesystem::remove(test_file));
+}
+
 }  // namespace my
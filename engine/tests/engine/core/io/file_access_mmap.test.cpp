@@ -0,0 +1,124 @@
+#include "engine/core/io/file_access_mmap.h"
+
+#include "engine/core/io/file_access_unix.h"
+
+namespace my {
+
+TEST(file_access_mmap, open_read_fail) {
+    auto err = FileAccessMmap::Open("file_access_mmap_open_read_fail").error();
+    EXPECT_EQ(err->value, ErrorCode::ERR_FILE_NOT_FOUND);
+}
+
+TEST(file_access_mmap, write_fail) {
+    FileAccess::MakeDefault<FileAccessUnix>(FileAccess::ACCESS_FILESYSTEM);
+    const std::string FILE_NAME = "file_access_mmap_write_fail";
+    {
+        auto f = FileAccess::Open(FILE_NAME, FileAccess::WRITE).value();
+        ASSERT_TRUE(f->WriteBuffer("abc", 3));
+    }
+    {
+        auto f = FileAccessMmap::Open(FILE_NAME).value();
+        EXPECT_EQ(f->WriteBuffer("abc", 3), 0);
+    }
+
+    ASSERT_TRUE(std::filesystem::remove(FILE_NAME));
+}
+
+TEST(file_access_mmap, empty_file) {
+    FileAccess::MakeDefault<FileAccessUnix>(FileAccess::ACCESS_FILESYSTEM);
+    const std::string FILE_NAME = "file_access_mmap_empty_file";
+    {
+        auto f = FileAccess::Open(FILE_NAME, FileAccess::WRITE).value();
+        ASSERT_TRUE(f->IsOpen());
+    }
+    {
+        auto f = FileAccessMmap::Open(FILE_NAME).value();
+        ASSERT_TRUE(f->IsOpen());
+        EXPECT_EQ(f->GetLength(), 0);
+
+        char buffer[4];
+        EXPECT_EQ(f->ReadBuffer(buffer, sizeof(buffer)), 0);
+        EXPECT_EQ(f->Consume(1), nullptr);
+    }
+
+    ASSERT_TRUE(std::filesystem::remove(FILE_NAME));
+}
+
+TEST(file_access_mmap, read_seek) {
+    FileAccess::MakeDefault<FileAccessUnix>(FileAccess::ACCESS_FILESYSTEM);
+    const std::string FILE_NAME = "file_access_mmap_read_seek";
+    const std::string STRING = "abcdefg";
+
+    {
+        auto f = FileAccess::Open(FILE_NAME, FileAccess::WRITE).value();
+        ASSERT_TRUE(f->WriteBuffer(STRING.data(), STRING.length()));
+    }
+    {
+        auto f = FileAccessMmap::Open(FILE_NAME).value();
+        ASSERT_TRUE(f->IsOpen());
+        EXPECT_EQ(f->GetLength(), STRING.length());
+        EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(f->GetData()), f->GetLength()), STRING);
+
+        char buffer[128]{ 0 };
+        EXPECT_EQ(f->ReadBuffer(buffer, 3), 3);
+        EXPECT_EQ(std::string(buffer), "abc");
+        EXPECT_EQ(f->Tell(), 3);
+
+        // reading past the end only returns what's left
+        EXPECT_EQ(f->ReadBuffer(buffer, sizeof(buffer)), 4);
+        EXPECT_EQ(f->Consume(1), nullptr);
+
+        EXPECT_EQ(f->Seek(1), 0);
+        const uint8_t* data = f->Consume(2);
+        ASSERT_NE(data, nullptr);
+        EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(data), 2), "bc");
+
+        EXPECT_NE(f->Seek(100), 0);
+    }
+
+    ASSERT_TRUE(std::filesystem::remove(FILE_NAME));
+}
+
+TEST(file_access_mmap, view) {
+    FileAccess::MakeDefault<FileAccessUnix>(FileAccess::ACCESS_FILESYSTEM);
+    const std::string FILE_NAME = "file_access_mmap_view";
+    const std::string STRING = "abcdefg";
+
+    {
+        auto f = FileAccess::Open(FILE_NAME, FileAccess::WRITE).value();
+        ASSERT_TRUE(f->WriteBuffer(STRING.data(), STRING.length()));
+    }
+
+    std::shared_ptr<FileAccessMmap> view;
+    {
+        auto f = FileAccessMmap::Open(FILE_NAME).value();
+        EXPECT_FALSE(FileAccessMmap::OpenView(f, 5, 3));
+        EXPECT_FALSE(FileAccessMmap::OpenView(f, 8, 0));
+
+        view = FileAccessMmap::OpenView(f, 2, 3).value();
+        f->Seek(6);
+    }
+
+    // the view keeps the mapping alive, and doesn't share the cursor
+    ASSERT_TRUE(view->IsOpen());
+    EXPECT_EQ(view->GetLength(), 3);
+    EXPECT_EQ(view->Tell(), 0);
+
+    char buffer[128]{ 0 };
+    EXPECT_EQ(view->ReadBuffer(buffer, sizeof(buffer)), 3);
+    EXPECT_EQ(std::string(buffer), "cde");
+    EXPECT_NE(view->Seek(4), 0);
+
+    auto sub_view = FileAccessMmap::OpenView(view, 1, 2).value();
+    const uint8_t* data = sub_view->Consume(2);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(data), 2), "de");
+
+    view->Close();
+    EXPECT_FALSE(view->IsOpen());
+    sub_view->Close();
+
+    ASSERT_TRUE(std::filesystem::remove(FILE_NAME));
+}
+
+}  // namespace my
@@ -0,0 +1,79 @@
+#include "engine/core/os/cpu_topology.h"
+
+#include <fstream>
+
+namespace my {
+
+namespace fs = std::filesystem;
+
+TEST(cpu_topology, parse_cpu_list) {
+    EXPECT_EQ(ParseCpuList("0"), (std::vector<uint32_t>{ 0 }));
+    EXPECT_EQ(ParseCpuList("0-3\n"), (std::vector<uint32_t>{ 0, 1, 2, 3 }));
+    EXPECT_EQ(ParseCpuList("8,0-1,10-11"), (std::vector<uint32_t>{ 0, 1, 8, 10, 11 }));
+    EXPECT_EQ(ParseCpuList("1,1-2"), (std::vector<uint32_t>{ 1, 2 }));
+}
+
+TEST(cpu_topology, parse_cpu_list_malformed) {
+    EXPECT_TRUE(ParseCpuList("").empty());
+    EXPECT_TRUE(ParseCpuList("a").empty());
+    EXPECT_TRUE(ParseCpuList("3-1").empty());
+    EXPECT_TRUE(ParseCpuList("0-").empty());
+    EXPECT_TRUE(ParseCpuList("0;1").empty());
+}
+
+static void WriteFile(const fs::path& p_path, std::string_view p_content) {
+    fs::create_directories(p_path.parent_path());
+    std::ofstream file(p_path);
+    file << p_content << '\n';
+}
+
+TEST(cpu_topology, read_sysfs) {
+    // 4 cores with 2 SMT siblings each (cpu i and i + 4), 2 numa nodes with their own L3
+    const fs::path root = "cpu_topology_read_sysfs";
+    fs::remove_all(root);
+
+    WriteFile(root / "cpu" / "online", "0-7");
+    WriteFile(root / "node" / "node0" / "cpulist", "0-1,4-5");
+    WriteFile(root / "node" / "node1" / "cpulist", "2-3,6-7");
+    for (uint32_t cpu = 0; cpu < 8; ++cpu) {
+        const uint32_t core = cpu % 4;
+        const uint32_t node = core / 2;
+        const fs::path dir = root / "cpu" / std::format("cpu{}", cpu);
+        WriteFile(dir / "topology" / "thread_siblings_list", std::format("{},{}", core, core + 4));
+        WriteFile(dir / "topology" / "physical_package_id", std::format("{}", node));
+        WriteFile(dir / "cache" / "index0" / "level", "1");
+        WriteFile(dir / "cache" / "index0" / "shared_cpu_list", std::format("{},{}", core, core + 4));
+        WriteFile(dir / "cache" / "index3" / "level", "3");
+        WriteFile(dir / "cache" / "index3" / "shared_cpu_list", node == 0 ? "0-1,4-5" : "2-3,6-7");
+    }
+
+    const CpuTopology topology = ReadSysfsTopology(root);
+    fs::remove_all(root);
+
+    ASSERT_TRUE(topology.detected);
+    EXPECT_EQ(topology.logicalCount, 8);
+    EXPECT_EQ(topology.numaNodeCount, 2);
+    EXPECT_EQ(topology.cacheClusterCount, 2);
+    ASSERT_EQ(topology.cores.size(), 4);
+    for (uint32_t i = 0; i < 4; ++i) {
+        const CpuCore& core = topology.cores[i];
+        EXPECT_EQ(core.logicalIds, (std::vector<uint32_t>{ i, i + 4 }));
+        EXPECT_EQ(core.numaNode, i / 2);
+        EXPECT_EQ(core.package, i / 2);
+        EXPECT_EQ(core.cacheCluster, i / 2);
+    }
+}
+
+TEST(cpu_topology, read_sysfs_missing) {
+    const CpuTopology topology = ReadSysfsTopology("cpu_topology_read_sysfs_missing");
+    EXPECT_FALSE(topology.detected);
+    EXPECT_TRUE(topology.cores.empty());
+}
+
+TEST(cpu_topology, detect) {
+    const CpuTopology topology = DetectCpuTopology();
+    ASSERT_FALSE(topology.cores.empty());
+    EXPECT_GE(topology.logicalCount, topology.cores.size());
+}
+
+}  // namespace my
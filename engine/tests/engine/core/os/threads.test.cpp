@@ -0,0 +1,61 @@
+#include "engine/core/os/threads.h"
+
+#include "engine/core/os/cpu_topology.h"
+
+namespace my::thread {
+
+static CpuTopology MakeTopology(uint32_t p_core_count, bool p_detected) {
+    CpuTopology topology;
+    topology.detected = p_detected;
+    topology.logicalCount = 2 * p_core_count;
+    for (uint32_t i = 0; i < p_core_count; ++i) {
+        topology.cores.push_back(CpuCore{ { i, i + p_core_count } });
+    }
+    return topology;
+}
+
+TEST(threads, layout_from_topology) {
+    const ThreadLayout small = ComputeThreadLayout(MakeTopology(4, true), ThreadConfig{});
+    EXPECT_EQ(small.jobWorkerCount, 3);
+
+    const ThreadLayout large = ComputeThreadLayout(MakeTopology(64, true), ThreadConfig{});
+    EXPECT_EQ(large.jobWorkerCount, 63);
+
+    const ThreadLayout single = ComputeThreadLayout(MakeTopology(1, true), ThreadConfig{});
+    EXPECT_EQ(single.jobWorkerCount, 1);
+    EXPECT_TRUE(single.jobWorkerAffinity.empty());
+}
+
+TEST(threads, layout_affinity) {
+    const ThreadLayout layout = ComputeThreadLayout(MakeTopology(4, true), ThreadConfig{});
+    ASSERT_EQ(layout.jobWorkerAffinity.size(), 3);
+    // the first core is left to the main thread, each worker gets all the siblings of its core
+    for (uint32_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(layout.jobWorkerAffinity[i], (std::vector<uint32_t>{ i + 1, i + 5 }));
+    }
+
+    ThreadConfig no_pin;
+    no_pin.pinJobWorkers = false;
+    EXPECT_TRUE(ComputeThreadLayout(MakeTopology(4, true), no_pin).jobWorkerAffinity.empty());
+
+    // SMT siblings might be reported as cores
+    EXPECT_TRUE(ComputeThreadLayout(MakeTopology(4, false), ThreadConfig{}).jobWorkerAffinity.empty());
+}
+
+TEST(threads, layout_override) {
+    ThreadConfig config;
+    config.jobWorkerCount = 6;
+    const ThreadLayout layout = ComputeThreadLayout(MakeTopology(4, true), config);
+    EXPECT_EQ(layout.jobWorkerCount, 6);
+
+    // more workers than cores, the extra ones are not pinned
+    ASSERT_EQ(layout.jobWorkerAffinity.size(), 6);
+    EXPECT_FALSE(layout.jobWorkerAffinity[2].empty());
+    EXPECT_TRUE(layout.jobWorkerAffinity[3].empty());
+    EXPECT_TRUE(layout.jobWorkerAffinity[5].empty());
+
+    config.jobWorkerCount = 100000;
+    EXPECT_EQ(ComputeThreadLayout(MakeTopology(4, true), config).jobWorkerCount, MAX_JOB_WORKER_COUNT);
+}
+
+}  // namespace my::thread
@@ -0,0 +1,46 @@
+#include "engine/core/string/string_id.h"
+
+namespace my {
+
+TEST(string_id, compile_time) {
+    static constexpr StringId s_id("string_id.compile_time");
+    static_assert(s_id.IsValid());
+    static_assert(s_id == StringId("string_id.compile_time"));
+    static_assert(s_id != StringId("string_id.compile_time2"));
+
+    EXPECT_EQ(StringId::Intern("string_id.compile_time"), s_id);
+    EXPECT_FALSE(StringId().IsValid());
+}
+
+TEST(string_id, get_string) {
+    const StringId id = StringId::Intern(std::string("string_id.get_string"));
+    EXPECT_EQ(id.GetString(), "string_id.get_string");
+    // interning again keeps the first copy
+    EXPECT_EQ(StringId::Intern("string_id.get_string").GetString().data(), id.GetString().data());
+
+    EXPECT_TRUE(StringId("string_id.never_interned").GetString().empty());
+}
+
+TEST(string_id, concurrent_intern) {
+    constexpr int THREAD_COUNT = 4;
+    constexpr int STRING_COUNT = 256;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < THREAD_COUNT; ++i) {
+        threads.emplace_back([]() {
+            for (int j = 0; j < STRING_COUNT; ++j) {
+                StringId::Intern(std::format("string_id.concurrent_{}", j));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int j = 0; j < STRING_COUNT; ++j) {
+        const std::string name = std::format("string_id.concurrent_{}", j);
+        EXPECT_EQ(StringId(name).GetString(), name);
+    }
+}
+
+}  // namespace my
@@ -0,0 +1,154 @@
+#include <random>
+
+#include "engine/math/culling.h"
+
+#include "engine/math/frustum.h"
+
+namespace my {
+
+static std::vector<AABB> CreateRandomBoxes(uint32_t p_count, uint32_t p_seed) {
+    std::mt19937 gen(p_seed);
+    std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> size(0.1f, 4.0f);
+
+    std::vector<AABB> boxes;
+    for (uint32_t i = 0; i < p_count; ++i) {
+        const Vector3f center(position(gen), position(gen), position(gen));
+        boxes.emplace_back(AABB::FromCenterSize(center, Vector3f(size(gen), size(gen), size(gen))));
+    }
+    return boxes;
+}
+
+// the box [-10, 10] with one corner cut off
+static Frustum CreateFrustum() {
+    Frustum frustum;
+    frustum[0] = Plane(Vector3f(1, 0, 0), 10.0f);
+    frustum[1] = Plane(Vector3f(-1, 0, 0), 10.0f);
+    frustum[2] = Plane(Vector3f(0, -1, 0), 10.0f);
+    frustum[3] = Plane(Vector3f(0, 1, 0), 10.0f);
+    frustum[4] = Plane(Vector3f(0, 0, 1), 10.0f);
+    frustum[5] = Plane(normalize(Vector3f(-1, -1, -1)), 10.0f);
+    return frustum;
+}
+
+// distance of the furthest corner along the normal of the closest plane, boxes right on a plane can
+// go either way depending on rounding
+static float FrustumMargin(const Frustum& p_frustum, const AABB& p_box) {
+    float margin = std::numeric_limits<float>::infinity();
+    for (int i = 0; i < 6; ++i) {
+        const Plane& plane = p_frustum[i];
+        Vector3f p;
+        p.x = plane.normal.x > 0.0f ? p_box.GetMax().x : p_box.GetMin().x;
+        p.y = plane.normal.y > 0.0f ? p_box.GetMax().y : p_box.GetMin().y;
+        p.z = plane.normal.z > 0.0f ? p_box.GetMax().z : p_box.GetMin().z;
+        margin = std::min(margin, std::abs(plane.Distance(p)));
+    }
+    return margin;
+}
+
+TEST(culling, empty) {
+    CullingBounds bounds;
+    std::vector<uint8_t> visible{ 1, 1, 1 };
+
+    bounds.CullFrustum(CreateFrustum(), visible);
+    EXPECT_TRUE(visible.empty());
+
+    bounds.CullAabb(AABB::FromCenterSize(Vector3f(0), Vector3f(1)), visible);
+    EXPECT_TRUE(visible.empty());
+}
+
+TEST(culling, add) {
+    CullingBounds bounds;
+    const AABB box(Vector3f(1, 2, 3), Vector3f(2, 6, 4));
+    for (uint32_t i = 0; i < CullingBounds::BATCH_SIZE + 1; ++i) {
+        EXPECT_EQ(bounds.Add(box), i);
+    }
+    EXPECT_EQ(bounds.GetSize(), CullingBounds::BATCH_SIZE + 1);
+
+    const AABB result = bounds.GetAabb(CullingBounds::BATCH_SIZE);
+    EXPECT_EQ(result.GetMin(), box.GetMin());
+    EXPECT_EQ(result.GetMax(), box.GetMax());
+
+    bounds.Clear();
+    EXPECT_EQ(bounds.GetSize(), 0);
+}
+
+TEST(culling, add_transformed) {
+    const AABB local(Vector3f(-1, -2, -3), Vector3f(3, 2, 1));
+
+    // rotate 90 degrees around z, scale by 2, then translate
+    Matrix4x4f matrix(0.0f);
+    matrix[0][1] = 2.0f;
+    matrix[1][0] = -2.0f;
+    matrix[2][2] = 2.0f;
+    matrix[3] = glm::vec4(10.0f, 20.0f, 30.0f, 1.0f);
+
+    AABB expected = local;
+    expected.ApplyMatrix(matrix);
+
+    CullingBounds bounds;
+    bounds.Add(local, matrix);
+    const AABB result = bounds.GetAabb(0);
+    for (int axis = 0; axis < 3; ++axis) {
+        EXPECT_NEAR(result.GetMin()[axis], expected.GetMin()[axis], 1e-5f);
+        EXPECT_NEAR(result.GetMax()[axis], expected.GetMax()[axis], 1e-5f);
+    }
+}
+
+TEST(culling, frustum) {
+    const Frustum frustum = CreateFrustum();
+    const std::vector<AABB> boxes = CreateRandomBoxes(1003, 7);
+
+    CullingBounds bounds;
+    bounds.Reserve(static_cast<uint32_t>(boxes.size()));
+    for (const AABB& box : boxes) {
+        bounds.Add(box);
+    }
+
+    std::vector<uint8_t> visible;
+    bounds.CullFrustum(frustum, visible);
+    ASSERT_EQ(visible.size(), boxes.size());
+
+    int visible_count = 0;
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        visible_count += visible[i];
+        if (FrustumMargin(frustum, boxes[i]) < 1e-3f) {
+            continue;
+        }
+        EXPECT_EQ(visible[i] != 0, frustum.Intersects(boxes[i])) << "box " << i;
+    }
+
+    // make sure the test covers both cases
+    EXPECT_GT(visible_count, 0);
+    EXPECT_LT(visible_count, static_cast<int>(boxes.size()));
+}
+
+TEST(culling, aabb) {
+    const AABB query = AABB::FromCenterSize(Vector3f(2, -3, 1), Vector3f(12, 16, 10));
+    std::vector<AABB> boxes = CreateRandomBoxes(517, 11);
+    // touching boxes don't intersect
+    boxes.emplace_back(Vector3f(8, -3, 1), Vector3f(9, -2, 2));
+    boxes.emplace_back(Vector3f(7, -3, 1), Vector3f(8, -2, 2));
+
+    CullingBounds bounds;
+    for (const AABB& box : boxes) {
+        bounds.Add(box);
+    }
+
+    std::vector<uint8_t> visible;
+    bounds.CullAabb(query, visible);
+    ASSERT_EQ(visible.size(), boxes.size());
+
+    int visible_count = 0;
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        visible_count += visible[i];
+        EXPECT_EQ(visible[i] != 0, query.Intersects(boxes[i])) << "box " << i;
+    }
+
+    EXPECT_GT(visible_count, 0);
+    EXPECT_LT(visible_count, static_cast<int>(boxes.size()));
+    EXPECT_FALSE(visible[visible.size() - 2]);
+    EXPECT_TRUE(visible[visible.size() - 1]);
+}
+
+}  // namespace my
@@ -0,0 +1,234 @@
+#include "engine/renderer/path_tracer/bvh_accel.h"
+
+namespace my {
+
+// a grid of p_size x p_size quads, two triangles each
+static void CreateGrid(int p_size, std::vector<uint32_t>& p_out_indices, std::vector<Vector3f>& p_out_vertices) {
+    for (int y = 0; y <= p_size; ++y) {
+        for (int x = 0; x <= p_size; ++x) {
+            p_out_vertices.emplace_back(Vector3f(static_cast<float>(x), static_cast<float>(y), static_cast<float>((x * y) % 3)));
+        }
+    }
+
+    const uint32_t stride = p_size + 1;
+    for (int y = 0; y < p_size; ++y) {
+        for (int x = 0; x < p_size; ++x) {
+            const uint32_t a = y * stride + x;
+            const uint32_t b = a + 1;
+            const uint32_t c = a + stride;
+            const uint32_t d = c + 1;
+            p_out_indices.insert(p_out_indices.end(), { a, b, c, b, d, c });
+        }
+    }
+}
+
+static bool Contains(const AABB& p_outer, const AABB& p_inner) {
+    for (int i = 0; i < 3; ++i) {
+        if (p_inner.GetMin()[i] < p_outer.GetMin()[i] || p_inner.GetMax()[i] > p_outer.GetMax()[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void ValidateNode(const BvhAccel& p_bvh, uint32_t p_index, uint32_t p_depth, std::vector<int>& p_visits) {
+    ASSERT_LT(p_index, p_bvh.nodes.size());
+    ASSERT_LT(p_depth, BvhAccel::MAX_DEPTH);
+
+    const BvhAccel::Node& node = p_bvh.nodes[p_index];
+    EXPECT_TRUE(node.aabb.IsValid());
+
+    if (node.IsLeaf()) {
+        EXPECT_LE(node.offset + node.count, p_bvh.primitives.size());
+        for (uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+            ++p_visits[p_bvh.primitives[i]];
+        }
+        return;
+    }
+
+    for (uint32_t child = node.offset; child < node.offset + 2; ++child) {
+        ASSERT_LT(child, p_bvh.nodes.size());
+        EXPECT_TRUE(Contains(node.aabb, p_bvh.nodes[child].aabb));
+        ValidateNode(p_bvh, child, p_depth + 1, p_visits);
+    }
+}
+
+static void Validate(const BvhAccel& p_bvh, uint32_t p_triangle_count) {
+    ASSERT_EQ(p_bvh.primitives.size(), p_triangle_count);
+    EXPECT_LE(p_bvh.nodes.size(), 2 * p_triangle_count - 1);
+
+    // every triangle is referenced by exactly one leaf
+    std::vector<int> visits(p_triangle_count, 0);
+    ValidateNode(p_bvh, 0, 0, visits);
+    for (int count : visits) {
+        EXPECT_EQ(count, 1);
+    }
+}
+
+TEST(bvh_accel, empty) {
+    auto bvh = BvhAccel::Construct({}, {});
+    ASSERT_NE(bvh, nullptr);
+    EXPECT_TRUE(bvh->IsEmpty());
+
+    std::vector<GpuPtBvh> gpu_bvhs;
+    bvh->FillGpuBvhAccel(gpu_bvhs);
+    EXPECT_TRUE(gpu_bvhs.empty());
+}
+
+TEST(bvh_accel, single_triangle) {
+    std::vector<Vector3f> vertices = { Vector3f(0, 0, 0), Vector3f(1, 0, 0), Vector3f(0, 1, 0) };
+    auto bvh = BvhAccel::Construct({ 0, 1, 2 }, vertices);
+    ASSERT_EQ(bvh->nodes.size(), 1);
+    EXPECT_TRUE(bvh->nodes[0].IsLeaf());
+    Validate(*bvh, 1);
+}
+
+TEST(bvh_accel, small_grid) {
+    std::vector<uint32_t> indices;
+    std::vector<Vector3f> vertices;
+    CreateGrid(8, indices, vertices);
+
+    auto bvh = BvhAccel::Construct(indices, vertices);
+    Validate(*bvh, 8 * 8 * 2);
+
+    for (const auto& node : bvh->nodes) {
+        EXPECT_LE(node.count, BvhAccel::MAX_LEAF_SIZE);
+    }
+}
+
+TEST(bvh_accel, degenerate_centroids) {
+    // all triangles on top of each other, binning can't split them
+    std::vector<Vector3f> vertices = { Vector3f(0, 0, 0), Vector3f(1, 0, 0), Vector3f(0, 1, 0) };
+    std::vector<uint32_t> indices;
+    for (int i = 0; i < 37; ++i) {
+        indices.insert(indices.end(), { 0, 1, 2 });
+    }
+
+    auto bvh = BvhAccel::Construct(indices, vertices);
+    Validate(*bvh, 37);
+}
+
+TEST(bvh_accel, large_grid) {
+    // big enough to build subtrees as jobs
+    std::vector<uint32_t> indices;
+    std::vector<Vector3f> vertices;
+    CreateGrid(128, indices, vertices);
+
+    auto bvh = BvhAccel::Construct(indices, vertices);
+    Validate(*bvh, 128 * 128 * 2);
+}
+
+TEST(bvh_accel, gpu_links) {
+    std::vector<uint32_t> indices;
+    std::vector<Vector3f> vertices;
+    CreateGrid(16, indices, vertices);
+    const int triangle_count = 16 * 16 * 2;
+
+    auto bvh = BvhAccel::Construct(indices, vertices);
+    std::vector<GpuPtBvh> gpu_bvhs;
+    bvh->FillGpuBvhAccel(gpu_bvhs);
+
+    // following hit links visits every node once and every triangle once
+    std::vector<int> visits(triangle_count, 0);
+    int steps = 0;
+    for (int index = 0; index >= 0; index = gpu_bvhs[index].hitIdx) {
+        ASSERT_LT(index, (int)gpu_bvhs.size());
+        ASSERT_LE(++steps, (int)gpu_bvhs.size());
+        if (gpu_bvhs[index].leaf) {
+            ASSERT_GE(gpu_bvhs[index].triangleIndex, 0);
+            ++visits[gpu_bvhs[index].triangleIndex];
+        } else {
+            EXPECT_EQ(gpu_bvhs[index].triangleIndex, -1);
+        }
+    }
+    EXPECT_EQ(steps, (int)gpu_bvhs.size());
+    for (int count : visits) {
+        EXPECT_EQ(count, 1);
+    }
+
+    // missing the root ends the traversal
+    EXPECT_EQ(gpu_bvhs[0].missIdx, -1);
+
+    // a miss link always points forward, past the subtree of the node
+    for (int i = 0; i < (int)gpu_bvhs.size(); ++i) {
+        if (gpu_bvhs[i].missIdx >= 0) {
+            EXPECT_GT(gpu_bvhs[i].missIdx, i);
+        }
+    }
+}
+
+TEST(bvh_accel, ray_closest_hit) {
+    std::vector<uint32_t> indices;
+    std::vector<Vector3f> vertices;
+    CreateGrid(32, indices, vertices);
+    auto bvh = BvhAccel::Construct(indices, vertices);
+
+    auto test_triangle = [&](Ray& p_ray, uint32_t p_triangle) {
+        return p_ray.Intersects(vertices[indices[3 * p_triangle]],
+                                vertices[indices[3 * p_triangle + 1]],
+                                vertices[indices[3 * p_triangle + 2]]);
+    };
+
+    int hit_count = 0;
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            const Vector3f start(2.0f * x + 0.3f, 2.0f * y + 0.6f, 10.0f);
+            const Vector3f end(2.0f * y + 0.1f, 2.0f * x + 0.4f, -10.0f);
+
+            // brute force reference, and make sure both sides agree on the closest distance
+            Ray reference(start, end);
+            bool expected = false;
+            for (uint32_t i = 0; i < indices.size() / 3; ++i) {
+                expected |= test_triangle(reference, i);
+            }
+
+            Ray ray(start, end);
+            const bool hit = bvh->Intersects(ray, [&](uint32_t p_triangle) {
+                return test_triangle(ray, p_triangle);
+            });
+
+            EXPECT_EQ(hit, expected);
+            EXPECT_FLOAT_EQ(ray.GetDist(), reference.GetDist());
+            hit_count += hit;
+        }
+    }
+    EXPECT_GT(hit_count, 0);
+}
+
+TEST(bvh_accel, ray_boxes) {
+    std::vector<AABB> aabbs;
+    for (int i = 0; i < 100; ++i) {
+        const float x = static_cast<float>(i);
+        aabbs.emplace_back(AABB(Vector3f(x, 0, 0), Vector3f(x + 0.5f, 1, 1)));
+    }
+    auto bvh = BvhAccel::Construct(aabbs);
+    Validate(*bvh, 100);
+
+    // goes along x, every box in front is visited, the ones behind the start are skipped
+    Ray ray(Vector3f(10.75f, 0.5f, 0.5f), Vector3f(200.0f, 0.5f, 0.5f));
+    std::vector<int> visits(aabbs.size(), 0);
+    bvh->Intersects(ray, [&](uint32_t p_box) {
+        ++visits[p_box];
+        return false;
+    });
+    EXPECT_EQ(visits[0], 0);
+    for (size_t i = 11; i < aabbs.size(); ++i) {
+        EXPECT_EQ(visits[i], 1);
+    }
+
+    // a hit shortens the ray, boxes further away are skipped
+    Ray closest(Vector3f(10.75f, 0.5f, 0.5f), Vector3f(200.0f, 0.5f, 0.5f));
+    std::vector<int> hits(aabbs.size(), 0);
+    bvh->Intersects(closest, [&](uint32_t p_box) {
+        ++hits[p_box];
+        return aabbs[p_box].Intersects(closest);
+    });
+    EXPECT_EQ(hits[11], 1);
+    EXPECT_EQ(hits[99], 0);
+
+    // misses everything
+    Ray miss(Vector3f(0, 5, 0), Vector3f(100, 5, 0));
+    EXPECT_FALSE(bvh->Intersects(miss, [](uint32_t) { return true; }));
+}
+
+}  // namespace my
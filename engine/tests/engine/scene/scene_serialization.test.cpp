@@ -0,0 +1,128 @@
+#include "engine/scene/scene_serialization.h"
+
+#include <fstream>
+
+#include "engine/core/io/file_access_unix.h"
+#include "engine/scene/scene.h"
+
+namespace my {
+
+static void CreateTestScene(Scene& p_scene) {
+    ecs::Entity::SetSeed();
+    p_scene.m_root = p_scene.CreateTransformEntity("root");
+    p_scene.CreateNameEntity("a");
+    p_scene.CreateTransformEntity("b");
+    p_scene.CreateTransformEntity("c");
+}
+
+static std::string ReadFile(const std::string& p_path) {
+    std::ifstream file(p_path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static void WriteFile(const std::string& p_path, const std::string& p_content) {
+    std::ofstream file(p_path, std::ios::binary | std::ios::trunc);
+    file.write(p_content.data(), p_content.size());
+}
+
+TEST(scene_serialization, binary_round_trip) {
+    FileAccess::MakeDefault<FileAccessUnix>(FileAccess::ACCESS_FILESYSTEM);
+    const std::string FILE_NAME = "scene_serialization_binary_round_trip";
+    {
+        Scene scene;
+        CreateTestScene(scene);
+        ASSERT_TRUE(SaveSceneBinary(FILE_NAME, scene));
+    }
+    {
+        Scene scene;
+        ASSERT_TRUE(LoadSceneBinary(FILE_NAME, scene));
+        EXPECT_EQ(scene.GetCount<NameComponent>(), 4u);
+        EXPECT_EQ(scene.GetCount<TransformComponent>(), 3u);
+        EXPECT_EQ(scene.m_root, scene.FindEntityByName("root"));
+        EXPECT_TRUE(scene.FindEntityByName("a").IsValid());
+        EXPECT_TRUE(scene.Contains<TransformComponent>(scene.FindEntityByName("c")));
+    }
+
+    ASSERT_TRUE(std::filesystem::remove(FILE_NAME));
+}
+
+TEST(scene_serialization, binary_skip_components) {
+    FileAccess::MakeDefault<FileAccessUnix>(FileAccess::ACCESS_FILESYSTEM);
+    const std::string FILE_NAME = "scene_serialization_binary_skip_components";
+    {
+        Scene scene;
+        CreateTestScene(scene);
+        ASSERT_TRUE(SaveSceneBinary(FILE_NAME, scene));
+    }
+    {
+        const std::string_view skipped[] = { "World::TransformComponent" };
+        Scene scene;
+        ASSERT_TRUE(LoadSceneBinary(FILE_NAME, scene, skipped));
+        EXPECT_EQ(scene.GetCount<NameComponent>(), 4u);
+        EXPECT_EQ(scene.GetCount<TransformComponent>(), 0u);
+    }
+
+    ASSERT_TRUE(std::filesystem::remove(FILE_NAME));
+}
+
+TEST(scene_serialization, binary_corrupt_toc) {
+    FileAccess::MakeDefault<FileAccessUnix>(FileAccess::ACCESS_FILESYSTEM);
+    const std::string FILE_NAME = "scene_serialization_binary_corrupt_toc";
+    {
+        Scene scene;
+        CreateTestScene(scene);
+        ASSERT_TRUE(SaveSceneBinary(FILE_NAME, scene));
+    }
+
+    const std::string content = ReadFile(FILE_NAME);
+    ASSERT_GT(content.size(), 16u);
+    uint64_t toc_offset = 0;
+    memcpy(&toc_offset, content.data() + content.size() - sizeof(toc_offset), sizeof(toc_offset));
+    const std::string toc_offset_bytes = content.substr(content.size() - sizeof(toc_offset));
+
+    // table of contents past the end of the file
+    {
+        std::string corrupt = content;
+        const uint64_t offset = content.size();
+        memcpy(corrupt.data() + corrupt.size() - sizeof(offset), &offset, sizeof(offset));
+        WriteFile(FILE_NAME, corrupt);
+
+        Scene scene;
+        auto res = LoadSceneBinary(FILE_NAME, scene);
+        ASSERT_FALSE(res);
+        EXPECT_EQ(res.error()->value, ErrorCode::ERR_FILE_CORRUPT);
+    }
+    // more chunks than the table holds
+    {
+        std::string corrupt = content;
+        const uint32_t chunk_count = 1000;
+        memcpy(corrupt.data() + toc_offset, &chunk_count, sizeof(chunk_count));
+        WriteFile(FILE_NAME, corrupt);
+
+        Scene scene;
+        auto res = LoadSceneBinary(FILE_NAME, scene);
+        ASSERT_FALSE(res);
+        EXPECT_EQ(res.error()->value, ErrorCode::ERR_FILE_CORRUPT);
+    }
+    // truncated, the last chunk size runs into the offset of the table
+    {
+        std::string corrupt = content.substr(0, content.size() - sizeof(toc_offset) - 4) + toc_offset_bytes;
+        WriteFile(FILE_NAME, corrupt);
+
+        Scene scene;
+        auto res = LoadSceneBinary(FILE_NAME, scene);
+        ASSERT_FALSE(res);
+        EXPECT_EQ(res.error()->value, ErrorCode::ERR_FILE_CORRUPT);
+    }
+    // file shorter than the header
+    {
+        WriteFile(FILE_NAME, content.substr(0, 4));
+
+        Scene scene;
+        EXPECT_FALSE(LoadSceneBinary(FILE_NAME, scene));
+    }
+
+    ASSERT_TRUE(std::filesystem::remove(FILE_NAME));
+}
+
+}  // namespace my
@@ -1,4 +1,5 @@
-#include "engine/systems/ecs/component_manager.h"
+#include "engine/core/io/archive.h"
+#include "engine/systems/ecs/component_manager.inl"
 
 namespace my::ecs {
 
@@ -25,6 +26,7 @@ struct A {
     int a;
 
     void Serialize(Archive&, uint32_t) {}
+    void OnDeserialized() {}
     static void RegisterClass() {
     }
 };
@@ -68,4 +70,133 @@ TEST(component_manager, iterator) {
     }
 }
 
+TEST(component_manager, create_remove) {
+    ComponentManager<A> manager;
+    Entity e1{ 1 }, e2{ 2 }, e3{ 3 };
+    manager.Create(e1).a = 1;
+    manager.Create(e2).a = 2;
+    manager.Create(e3).a = 3;
+    EXPECT_EQ(manager.GetCount(), 3);
+
+    manager.Remove(e1);
+    EXPECT_EQ(manager.GetCount(), 2);
+    EXPECT_FALSE(manager.Contains(e1));
+    EXPECT_EQ(manager.GetComponent(e1), nullptr);
+    ASSERT_NE(manager.GetComponent(e2), nullptr);
+    ASSERT_NE(manager.GetComponent(e3), nullptr);
+    EXPECT_EQ(manager.GetComponent(e2)->a, 2);
+    EXPECT_EQ(manager.GetComponent(e3)->a, 3);
+
+    // removing twice is fine
+    manager.Remove(e1);
+    EXPECT_EQ(manager.GetCount(), 2);
+}
+
+TEST(component_manager, version) {
+    ComponentManager<A> manager;
+    Entity e1{ 1 }, e2{ 2 };
+
+    uint32_t version = manager.GetVersion();
+    manager.Create(e1);
+    EXPECT_NE(manager.GetVersion(), version);
+
+    version = manager.GetVersion();
+    manager.Create(e2);
+    EXPECT_NE(manager.GetVersion(), version);
+
+    // modifying a component doesn't change the layout
+    version = manager.GetVersion();
+    manager.GetComponent(e1)->a = 10;
+    EXPECT_EQ(manager.GetVersion(), version);
+
+    // removing something that isn't there doesn't either
+    manager.Remove(Entity{ 3 });
+    EXPECT_EQ(manager.GetVersion(), version);
+
+    manager.Remove(e1);
+    EXPECT_NE(manager.GetVersion(), version);
+
+    version = manager.GetVersion();
+    manager.Clear();
+    EXPECT_NE(manager.GetVersion(), version);
+}
+
+TEST(component_manager, stale_generation) {
+    ComponentManager<A> manager;
+    Entity old_entity(4, 0);
+    Entity new_entity(4, 1);
+    manager.Create(new_entity).a = 10;
+
+    EXPECT_TRUE(manager.Contains(new_entity));
+    EXPECT_FALSE(manager.Contains(old_entity));
+    EXPECT_EQ(manager.GetComponent(old_entity), nullptr);
+    manager.Remove(old_entity);
+    EXPECT_EQ(manager.GetCount(), 1);
+}
+
+TEST(component_manager, sparse_pages) {
+    ComponentManager<A> manager;
+    Entity far_entity(SparseSet::PAGE_SIZE * 3 + 7, 0);
+    manager.Create(far_entity).a = 7;
+    EXPECT_FALSE(manager.Contains(Entity{ 7 }));
+    EXPECT_FALSE(manager.Contains(Entity(SparseSet::PAGE_SIZE * 100, 0)));
+    ASSERT_NE(manager.GetComponent(far_entity), nullptr);
+    EXPECT_EQ(manager.GetComponent(far_entity)->a, 7);
+
+    ComponentManager<A> copy;
+    copy.Copy(manager);
+    EXPECT_TRUE(copy.Contains(far_entity));
+
+    ComponentManager<A> merged;
+    merged.Create(Entity{ 1 });
+    merged.Merge(copy);
+    EXPECT_EQ(copy.GetCount(), 0);
+    EXPECT_TRUE(merged.Contains(Entity{ 1 }));
+    EXPECT_TRUE(merged.Contains(far_entity));
+}
+
+TEST(component_manager, memory_resource) {
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        size_t allocated = 0;
+
+    private:
+        void* do_allocate(size_t p_bytes, size_t p_alignment) override {
+            allocated += p_bytes;
+            return std::pmr::new_delete_resource()->allocate(p_bytes, p_alignment);
+        }
+        void do_deallocate(void* p_ptr, size_t p_bytes, size_t p_alignment) override {
+            allocated -= p_bytes;
+            std::pmr::new_delete_resource()->deallocate(p_ptr, p_bytes, p_alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& p_other) const noexcept override { return this == &p_other; }
+    };
+
+    CountingResource resource_1;
+    CountingResource resource_2;
+    // anything falling back to the default resource throws
+    std::pmr::memory_resource* old_default = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    {
+        ComponentManager<A> manager(0, &resource_1);
+        for (uint32_t i = 1; i <= 100; ++i) {
+            manager.Create(Entity(i, 0)).a = static_cast<int>(i);
+        }
+        manager.Create(Entity(SparseSet::PAGE_SIZE * 2, 0));
+        EXPECT_GT(resource_1.allocated, 0u);
+
+        ComponentManager<A> copy(0, &resource_2);
+        copy.Copy(manager);
+        EXPECT_GT(resource_2.allocated, 0u);
+        EXPECT_EQ(copy.GetComponent(Entity(42, 0))->a, 42);
+
+        ComponentManager<A> merged(0, &resource_2);
+        merged.Merge(copy);
+        EXPECT_EQ(merged.GetCount(), 101u);
+    }
+    std::pmr::set_default_resource(old_default);
+
+    EXPECT_EQ(resource_1.allocated, 0u);
+    EXPECT_EQ(resource_2.allocated, 0u);
+}
+
 }  // namespace my::ecs
@@ -0,0 +1,42 @@
+#include "engine/systems/ecs/entity.h"
+
+namespace my::ecs {
+
+TEST(entity, index_and_generation) {
+    Entity entity(5, 3);
+    EXPECT_EQ(entity.GetIndex(), 5);
+    EXPECT_EQ(entity.GetGeneration(), 3);
+    EXPECT_TRUE(entity.IsValid());
+
+    // generation 0 handles are compatible with plain ids
+    EXPECT_EQ(Entity(7, 0), Entity(7));
+    EXPECT_NE(Entity(7, 1), Entity(7));
+    EXPECT_FALSE(Entity::INVALID.IsValid());
+}
+
+TEST(entity, recycle) {
+    Entity::SetSeed();
+    Entity a = Entity::Create();
+    Entity b = Entity::Create();
+    EXPECT_EQ(a.GetIndex(), 1);
+    EXPECT_EQ(b.GetIndex(), 2);
+
+    Entity::Destroy(a);
+    Entity c = Entity::Create();
+    EXPECT_EQ(c.GetIndex(), a.GetIndex());
+    EXPECT_EQ(c.GetGeneration(), a.GetGeneration() + 1);
+    EXPECT_NE(c, a);
+
+    Entity d = Entity::Create();
+    EXPECT_EQ(d.GetIndex(), 3);
+}
+
+TEST(entity, set_seed_clears_free_list) {
+    Entity::SetSeed();
+    Entity a = Entity::Create();
+    Entity::Destroy(a);
+    Entity::SetSeed(10);
+    EXPECT_EQ(Entity::Create().GetIndex(), 10);
+}
+
+}  // namespace my::ecs
@@ -0,0 +1,94 @@
+#include "engine/systems/ecs/system_graph.h"
+
+namespace my::ecs {
+
+enum : ComponentMask {
+    COMPONENT_A = 1 << 0,
+    COMPONENT_B = 1 << 1,
+    COMPONENT_C = 1 << 2,
+};
+
+static SystemDesc MakeSystem(const char* p_name, ComponentMask p_reads, ComponentMask p_writes, std::vector<std::string>* p_log = nullptr) {
+    SystemDesc desc;
+    desc.name = p_name;
+    desc.reads = p_reads;
+    desc.writes = p_writes;
+    desc.update = [p_name, p_log]() {
+        if (p_log) {
+            p_log->push_back(p_name);
+        }
+    };
+    return desc;
+}
+
+TEST(system_graph, dependencies) {
+    SystemGraph graph;
+    graph.Register(MakeSystem("write_a", 0, COMPONENT_A));
+    graph.Register(MakeSystem("read_a", COMPONENT_A, 0));
+    graph.Register(MakeSystem("read_a_again", COMPONENT_A, 0));
+    graph.Register(MakeSystem("write_b", 0, COMPONENT_B));
+    graph.Register(MakeSystem("write_a_read_b", COMPONENT_B, COMPONENT_A));
+
+    EXPECT_TRUE(graph.GetDependencies(0).empty());
+    // readers only wait for the writer, not for each other
+    EXPECT_EQ(graph.GetDependencies(1), std::vector<uint32_t>({ 0 }));
+    EXPECT_EQ(graph.GetDependencies(2), std::vector<uint32_t>({ 0 }));
+    EXPECT_TRUE(graph.GetDependencies(3).empty());
+    // the write waits for both readers, which already wait for the first writer
+    EXPECT_EQ(graph.GetDependencies(4), std::vector<uint32_t>({ 1, 2, 3 }));
+}
+
+TEST(system_graph, transitive_dependencies) {
+    SystemGraph graph;
+    graph.Register(MakeSystem("write_a", 0, COMPONENT_A));
+    graph.Register(MakeSystem("write_ab", 0, COMPONENT_A | COMPONENT_B));
+    graph.Register(MakeSystem("write_abc", 0, COMPONENT_A | COMPONENT_B | COMPONENT_C));
+
+    EXPECT_EQ(graph.GetDependencies(1), std::vector<uint32_t>({ 0 }));
+    // covered by waiting for write_ab
+    EXPECT_EQ(graph.GetDependencies(2), std::vector<uint32_t>({ 1 }));
+}
+
+TEST(system_graph, run_in_order) {
+    std::vector<std::string> log;
+    SystemGraph graph;
+    graph.Register(MakeSystem("first", 0, COMPONENT_A | COMPONENT_B, &log));
+    graph.Register(MakeSystem("second", COMPONENT_A, COMPONENT_B, &log));
+    graph.Register(MakeSystem("third", COMPONENT_B, 0, &log));
+
+    for (int frame = 0; frame < 3; ++frame) {
+        log.clear();
+        jobsystem::Context ctx;
+        graph.Run(ctx);
+        ctx.Wait();
+        EXPECT_EQ(log, std::vector<std::string>({ "first", "second", "third" }));
+    }
+}
+
+TEST(system_graph, run_dispatching_system) {
+    std::atomic_int counter = 0;
+    int total = 0;
+
+    SystemGraph graph;
+    SystemDesc producer;
+    producer.name = "producer";
+    producer.writes = COMPONENT_A;
+    producer.run = [&counter](jobsystem::Context& p_context, const jobsystem::JobHandle& p_dependency) {
+        return p_context.Then(p_dependency, 64, 4, [&counter](jobsystem::JobArgs) { counter.fetch_add(1); });
+    };
+    graph.Register(std::move(producer));
+    SystemDesc check;
+    check.name = "check";
+    check.reads = COMPONENT_A;
+    check.update = [&counter, &total]() { total = counter.load(); };
+    graph.Register(std::move(check));
+
+    jobsystem::Context ctx;
+    const jobsystem::JobHandle handle = graph.Run(ctx);
+    ctx.Wait(handle);
+    EXPECT_TRUE(handle.IsDone());
+    EXPECT_EQ(total, 64);
+    ctx.Wait();
+}
+
+}  // namespace my::ecs
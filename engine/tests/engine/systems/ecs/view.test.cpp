@@ -24,7 +24,7 @@ TEST(view, iterator) {
 
     int i = 0;
     for (auto [id, name] : scene.View<NameComponent>()) {
-        name.GetNameRef().push_back(static_cast<char>('0' + i));
+        name.SetName(name.GetName() + static_cast<char>('0' + i));
         ++i;
     }
 
@@ -36,4 +36,53 @@ TEST(view, iterator) {
     }
 }
 
+TEST(view, no_copy) {
+    Entity::SetSeed();
+    Scene scene;
+    for (int i = 0; i < 4; ++i) {
+        scene.CreateNameEntity(std::format("entity_{}", i));
+    }
+
+    int i = 0;
+    for (auto [id, name] : scene.View<NameComponent>()) {
+        EXPECT_EQ(&name, &scene.GetComponentByIndex<NameComponent>(i));
+        EXPECT_EQ(id, scene.GetEntity<NameComponent>(i));
+        ++i;
+    }
+    EXPECT_EQ(i, 4);
+}
+
+TEST(view, join) {
+    Entity::SetSeed();
+    Scene scene;
+    const Scene& const_scene = scene;
+    auto a = scene.CreateNameEntity("a");
+    auto b = scene.CreateTransformEntity("b");
+    auto c = scene.CreateNameEntity("c");
+    auto d = scene.CreateTransformEntity("d");
+    scene.Create<TransformComponent>(c);
+    scene.Create<MeshComponent>(d);
+
+    std::vector<Entity> visited;
+    for (auto [id, name, transform] : scene.View<NameComponent, TransformComponent>()) {
+        EXPECT_EQ(&name, scene.GetComponent<NameComponent>(id));
+        EXPECT_EQ(&transform, scene.GetComponent<TransformComponent>(id));
+        visited.push_back(id);
+    }
+    std::sort(visited.begin(), visited.end(), std::less<Entity>());
+    EXPECT_EQ(visited, (std::vector<Entity>{ b, c, d }));
+
+    visited.clear();
+    for (auto [id, name, transform, mesh] : const_scene.View<NameComponent, TransformComponent, MeshComponent>()) {
+        CheckConst(name);
+        CheckConst(transform);
+        CheckConst(mesh);
+        visited.push_back(id);
+    }
+    EXPECT_EQ(visited, (std::vector<Entity>{ d }));
+
+    scene.Create<MeshComponent>(a);
+    EXPECT_EQ(scene.View<NameComponent, MeshComponent>().GetSize(), 2);
+}
+
 }  // namespace my::ecs
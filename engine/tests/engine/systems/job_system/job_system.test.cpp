@@ -0,0 +1,361 @@
+#include "engine/systems/job_system/job_system.h"
+
+#include <latch>
+
+#include "engine/core/os/threads.h"
+
+namespace my::jobsystem {
+
+TEST(job_system, dispatch) {
+    std::array<std::atomic_int, 100> counters{};
+
+    Context ctx;
+    const JobHandle handle = ctx.Dispatch(100, 8, [&](JobArgs p_args) {
+        counters[p_args.jobIndex].fetch_add(1);
+    });
+    ctx.Wait(handle);
+    EXPECT_TRUE(handle.IsDone());
+    for (const auto& counter : counters) {
+        EXPECT_EQ(counter.load(), 1);
+    }
+
+    ctx.Wait();
+    EXPECT_FALSE(ctx.IsBusy());
+}
+
+TEST(job_system, empty_handle) {
+    const JobHandle handle;
+    EXPECT_TRUE(handle.IsDone());
+
+    Context ctx;
+    EXPECT_TRUE(ctx.Dispatch(0, 1, [](JobArgs) {}).IsDone());
+
+    std::atomic_int counter = 0;
+    ctx.Wait(ctx.Then(handle, 1, 1, [&](JobArgs) { counter.fetch_add(1); }));
+    EXPECT_EQ(counter.load(), 1);
+}
+
+TEST(job_system, then) {
+    constexpr uint32_t STAGE_COUNT = 6;
+    constexpr uint32_t JOB_COUNT = 64;
+    std::array<std::atomic_uint32_t, STAGE_COUNT> finished{};
+    std::atomic_int errors = 0;
+
+    Context ctx;
+    JobHandle handle;
+    for (uint32_t stage = 0; stage < STAGE_COUNT; ++stage) {
+        handle = ctx.Then(handle, JOB_COUNT, 4, [&, stage](JobArgs) {
+            // every job of the previous stage must be done
+            if (stage > 0 && finished[stage - 1].load() != JOB_COUNT) {
+                errors.fetch_add(1);
+            }
+            finished[stage].fetch_add(1);
+        });
+    }
+
+    ctx.Wait();
+    EXPECT_EQ(errors.load(), 0);
+    for (const auto& count : finished) {
+        EXPECT_EQ(count.load(), JOB_COUNT);
+    }
+}
+
+TEST(job_system, when_all) {
+    std::atomic_int first = 0;
+    std::atomic_int second = 0;
+    std::atomic_int result = -1;
+
+    Context ctx;
+    const JobHandle handles[] = {
+        ctx.Dispatch(32, 1, [&](JobArgs) { first.fetch_add(1); }),
+        ctx.Dispatch(16, 4, [&](JobArgs) { second.fetch_add(2); }),
+    };
+    const JobHandle joined = ctx.WhenAll(handles);
+    const JobHandle last = ctx.Then(joined, 1, 1, [&](JobArgs) {
+        result.store(first.load() + second.load());
+    });
+
+    ctx.Wait(last);
+    EXPECT_TRUE(joined.IsDone());
+    EXPECT_EQ(result.load(), 64);
+}
+
+TEST(job_system, nested_dispatch) {
+    std::atomic_int counter = 0;
+
+    Context ctx;
+    ctx.Dispatch(8, 1, [&](JobArgs) {
+        Context inner;
+        const JobHandle a = inner.Dispatch(4, 1, [&](JobArgs) { counter.fetch_add(1); });
+        inner.Then(a, 4, 1, [&](JobArgs) { counter.fetch_add(1); });
+    });
+    ctx.Wait();
+
+    EXPECT_EQ(counter.load(), 64);
+}
+
+// Only holds without workers, where the waiting thread runs every job itself, lane by lane. Workers pick
+// up the background jobs as soon as they are queued.
+TEST(job_system, priority_order) {
+    constexpr uint32_t JOB_COUNT = 16;
+    std::atomic_uint32_t order = 0;
+    std::array<uint32_t, JOB_COUNT> background_order{};
+    std::array<uint32_t, JOB_COUNT> critical_order{};
+
+    // background jobs are queued first, the critical ones still run before them
+    Context background(JOB_PRIORITY_BACKGROUND);
+    Context critical(JOB_PRIORITY_CRITICAL);
+    background.Dispatch(JOB_COUNT, 1, [&](JobArgs p_args) {
+        background_order[p_args.jobIndex] = order.fetch_add(1);
+    });
+    critical.Dispatch(JOB_COUNT, 1, [&](JobArgs p_args) {
+        critical_order[p_args.jobIndex] = order.fetch_add(1);
+    });
+    critical.Wait();
+    background.Wait();
+
+    const uint32_t last_critical = *std::max_element(critical_order.begin(), critical_order.end());
+    const uint32_t first_background = *std::min_element(background_order.begin(), background_order.end());
+    EXPECT_LT(last_critical, first_background);
+    EXPECT_EQ(order.load(), 2 * JOB_COUNT);
+}
+
+TEST(job_system, inherit_priority) {
+    EXPECT_EQ(Context().GetPriority(), JOB_PRIORITY_NORMAL);
+
+    std::atomic_int inner_priority = -1;
+    std::atomic_int current_priority = -1;
+    Context ctx(JOB_PRIORITY_BACKGROUND);
+    ctx.Dispatch(1, 1, [&](JobArgs) {
+        Context inner;
+        inner_priority = inner.GetPriority();
+        current_priority = GetCurrentPriority();
+    });
+    ctx.Wait();
+
+    EXPECT_EQ(inner_priority.load(), JOB_PRIORITY_BACKGROUND);
+    EXPECT_EQ(current_priority.load(), JOB_PRIORITY_BACKGROUND);
+    EXPECT_EQ(GetCurrentPriority(), JOB_PRIORITY_NORMAL);
+}
+
+TEST(job_system, run_async) {
+    std::atomic_int counter = 0;
+    for (int i = 0; i < 8; ++i) {
+        RunAsync(JOB_PRIORITY_BACKGROUND, [&]() { counter.fetch_add(1); });
+    }
+
+    // detached jobs are picked up by whoever helps with background work
+    Context ctx(JOB_PRIORITY_BACKGROUND);
+    while (counter.load() != 8) {
+        ctx.Dispatch(1, 1, [](JobArgs) {});
+        ctx.Wait();
+    }
+    EXPECT_EQ(counter.load(), 8);
+}
+
+TEST(job_system, run_jobs_until) {
+    std::atomic_int counter = 0;
+    for (int i = 0; i < 8; ++i) {
+        RunAsync(JOB_PRIORITY_BACKGROUND, [&]() { counter.fetch_add(1); });
+    }
+
+    RunJobsUntil(JOB_PRIORITY_BACKGROUND, [&]() { return counter.load() == 8; });
+    EXPECT_EQ(counter.load(), 8);
+}
+
+// The tests above run every job on the waiting thread, these start real workers.
+class job_system_workers : public testing::Test {
+protected:
+    static constexpr uint32_t WORKER_COUNT = 4;
+    // a quarter of the workers is kept for frame work, see jobsystem::Initialize()
+    static constexpr int BACKGROUND_SLOT_COUNT = 3;
+
+    void SetUp() override {
+        thread::ThreadLayout layout;
+        layout.jobWorkerCount = WORKER_COUNT;
+        jobsystem::Initialize(WORKER_COUNT);
+        thread::Initialize(layout);
+    }
+
+    void TearDown() override {
+        thread::RequestShutdown();
+        jobsystem::Finalize();
+        thread::Finailize();
+
+        // back to running the jobs on the waiting thread
+        jobsystem::Initialize(0);
+        thread::Initialize(thread::ThreadLayout{});
+    }
+
+    // spins without running any job, so only the workers can make p_done hold. False after a timeout, the
+    // context destructors then help to finish the jobs instead of hanging the test.
+    template<typename PRED>
+    static bool SpinUntil(PRED&& p_done) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while (!p_done()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    static void ExpectRunOnce(const std::vector<std::atomic_int>& p_counters) {
+        for (size_t i = 0; i < p_counters.size(); ++i) {
+            EXPECT_EQ(p_counters[i].load(), 1) << "job " << i;
+        }
+    }
+};
+
+TEST_F(job_system_workers, steal) {
+    constexpr uint32_t JOB_COUNT = 512;
+    std::vector<std::atomic_int> counters(JOB_COUNT);
+    std::vector<int> ran_on(JOB_COUNT, -1);
+    std::atomic_int owner = -1;
+
+    // the jobs go to the queue of the worker that dispatches them, the others can only steal them
+    Context ctx;
+    const JobHandle handle = ctx.Dispatch(1, 1, [&](JobArgs) {
+        owner = thread::GetJobWorkerIndex();
+        Context inner;
+        inner.Dispatch(JOB_COUNT, 1, [&](JobArgs p_args) {
+            counters[p_args.jobIndex].fetch_add(1);
+            ran_on[p_args.jobIndex] = thread::GetJobWorkerIndex();
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+        });
+        inner.Wait();
+    });
+    EXPECT_TRUE(SpinUntil([&]() { return handle.IsDone(); }));
+    ctx.Wait();
+
+    ExpectRunOnce(counters);
+    EXPECT_GE(owner.load(), 0);
+    const auto stolen = std::count_if(ran_on.begin(), ran_on.end(), [&](int p_worker) {
+        return p_worker >= 0 && p_worker != owner.load();
+    });
+    EXPECT_EQ(std::count(ran_on.begin(), ran_on.end(), -1), 0);
+    EXPECT_GT(stolen, 0);
+}
+
+TEST_F(job_system_workers, injection_overflow) {
+    // twice the injection queue per dispatch, the rest spills into the overflow list
+    constexpr uint32_t JOB_COUNT = 2 * 4096;
+    constexpr uint32_t OUTSIDE_THREAD_COUNT = 3;
+    constexpr uint32_t SUBMITTER_COUNT = OUTSIDE_THREAD_COUNT + 1;
+    std::vector<std::atomic_int> counters(SUBMITTER_COUNT * JOB_COUNT);
+    std::latch start{ SUBMITTER_COUNT };
+
+    auto submit = [&](uint32_t p_submitter) {
+        Context ctx;
+        start.arrive_and_wait();
+        ctx.Dispatch(JOB_COUNT, 1, [&, p_submitter](JobArgs p_args) {
+            counters[p_submitter * JOB_COUNT + p_args.jobIndex].fetch_add(1);
+        });
+        ctx.Wait();
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < OUTSIDE_THREAD_COUNT; ++i) {
+        threads.emplace_back(submit, i + 1);
+    }
+    submit(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ExpectRunOnce(counters);
+}
+
+TEST_F(job_system_workers, nested_wait) {
+    constexpr uint32_t OUTER_COUNT = 16;
+    constexpr uint32_t INNER_COUNT = 64;
+    std::vector<std::atomic_int> counters(OUTER_COUNT * INNER_COUNT);
+    std::atomic_int errors = 0;
+
+    Context ctx;
+    const JobHandle handle = ctx.Dispatch(OUTER_COUNT, 1, [&](JobArgs p_args) {
+        if (thread::GetJobWorkerIndex() < 0) {
+            errors.fetch_add(1);
+        }
+
+        std::atomic_uint32_t finished = 0;
+        Context inner;
+        inner.Dispatch(INNER_COUNT, 4, [&, outer = p_args.jobIndex](JobArgs p_inner) {
+            counters[outer * INNER_COUNT + p_inner.jobIndex].fetch_add(1);
+            finished.fetch_add(1);
+        });
+        // the worker helps with the queued jobs until its own are done
+        inner.Wait();
+        if (finished.load() != INNER_COUNT) {
+            errors.fetch_add(1);
+        }
+    });
+    EXPECT_TRUE(SpinUntil([&]() { return handle.IsDone(); }));
+    ctx.Wait();
+
+    EXPECT_EQ(errors.load(), 0);
+    ExpectRunOnce(counters);
+}
+
+TEST_F(job_system_workers, background_slots) {
+    constexpr uint32_t BACKGROUND_COUNT = 8;
+    constexpr uint32_t CRITICAL_COUNT = 256;
+    std::atomic_int running = 0;
+    std::atomic_int max_running = 0;
+    std::atomic_int finished = 0;
+    std::atomic_bool release = false;
+
+    Context background(JOB_PRIORITY_BACKGROUND);
+    background.Dispatch(BACKGROUND_COUNT, 1, [&](JobArgs) {
+        const int now = running.fetch_add(1) + 1;
+        int max = max_running.load();
+        while (now > max && !max_running.compare_exchange_weak(max, now)) {
+        }
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+        running.fetch_sub(1);
+        finished.fetch_add(1);
+    });
+    EXPECT_TRUE(SpinUntil([&]() { return running.load() == BACKGROUND_SLOT_COUNT; }));
+
+    // every slot is taken, the worker kept for frame work still gets through the critical jobs
+    std::vector<std::atomic_int> counters(CRITICAL_COUNT);
+    Context critical(JOB_PRIORITY_CRITICAL);
+    const JobHandle handle = critical.Dispatch(CRITICAL_COUNT, 4, [&](JobArgs p_args) {
+        counters[p_args.jobIndex].fetch_add(1);
+    });
+    EXPECT_TRUE(SpinUntil([&]() { return handle.IsDone(); }));
+    critical.Wait();
+    EXPECT_EQ(running.load(), BACKGROUND_SLOT_COUNT);
+
+    release = true;
+    background.Wait();
+
+    ExpectRunOnce(counters);
+    EXPECT_EQ(finished.load(), BACKGROUND_COUNT);
+    EXPECT_EQ(max_running.load(), BACKGROUND_SLOT_COUNT);
+}
+
+TEST_F(job_system_workers, sleep_and_wake) {
+    constexpr uint32_t BURST_COUNT = 20;
+    constexpr uint32_t JOB_COUNT = 64;
+    std::vector<std::atomic_int> counters(BURST_COUNT * JOB_COUNT);
+
+    Context ctx;
+    for (uint32_t burst = 0; burst < BURST_COUNT; ++burst) {
+        // long enough for the idle workers to run out of backoff and park
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+        const JobHandle handle = ctx.Dispatch(JOB_COUNT, 1, [&, burst](JobArgs p_args) {
+            counters[burst * JOB_COUNT + p_args.jobIndex].fetch_add(1);
+        });
+        EXPECT_TRUE(SpinUntil([&]() { return handle.IsDone(); })) << "burst " << burst;
+        ctx.Wait();
+    }
+
+    ExpectRunOnce(counters);
+}
+
+}  // namespace my::jobsystem
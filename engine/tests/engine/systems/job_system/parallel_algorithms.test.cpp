@@ -0,0 +1,159 @@
+#include "engine/systems/job_system/parallel_algorithms.h"
+
+#include <random>
+
+namespace my::jobsystem {
+
+// small grains, so even the small ranges get cut into several blocks
+static constexpr size_t TEST_GRAIN = 100;
+static constexpr size_t TEST_COUNTS[] = { 0, 1, 99, 300, 1000, 100003 };
+
+struct KeyValue {
+    uint32_t key;
+    uint32_t index;
+
+    bool operator==(const KeyValue&) const = default;
+};
+
+static std::vector<KeyValue> MakeKeyValues(size_t p_count, uint32_t p_max_key) {
+    std::mt19937 random(static_cast<uint32_t>(p_count));
+    std::uniform_int_distribution<uint32_t> distribution(0, p_max_key);
+    std::vector<KeyValue> values(p_count);
+    for (size_t i = 0; i < p_count; ++i) {
+        values[i] = { distribution(random), static_cast<uint32_t>(i) };
+    }
+    return values;
+}
+
+static std::vector<int> MakeInts(size_t p_count) {
+    std::vector<int> values(p_count);
+    for (size_t i = 0; i < p_count; ++i) {
+        values[i] = static_cast<int>(i % 17) - 8;
+    }
+    return values;
+}
+
+TEST(parallel_algorithms, reduce) {
+    for (size_t count : TEST_COUNTS) {
+        const auto values = MakeInts(count);
+        EXPECT_EQ(ParallelReduce(values.begin(), values.end(), 5, std::plus<>(), TEST_GRAIN),
+                  std::accumulate(values.begin(), values.end(), 5));
+    }
+}
+
+TEST(parallel_algorithms, reduce_keeps_order) {
+    std::vector<std::string> values;
+    std::string expected = ">";
+    for (int i = 0; i < 26; ++i) {
+        values.push_back(std::string(1, static_cast<char>('a' + i)));
+        expected += values.back();
+    }
+
+    EXPECT_EQ(ParallelReduce(values.begin(), values.end(), std::string(">"), std::plus<>(), 3), expected);
+}
+
+TEST(parallel_algorithms, inclusive_scan) {
+    for (size_t count : TEST_COUNTS) {
+        auto values = MakeInts(count);
+        std::vector<int> expected(count);
+        std::inclusive_scan(values.begin(), values.end(), expected.begin());
+
+        std::vector<int> result(count);
+        EXPECT_EQ(ParallelInclusiveScan(values.begin(), values.end(), result.begin(), std::plus<>(), TEST_GRAIN),
+                  result.end());
+        EXPECT_EQ(result, expected);
+
+        ParallelInclusiveScan(values.begin(), values.end(), values.begin(), std::plus<>(), TEST_GRAIN);
+        EXPECT_EQ(values, expected);
+    }
+}
+
+TEST(parallel_algorithms, exclusive_scan) {
+    for (size_t count : TEST_COUNTS) {
+        auto values = MakeInts(count);
+        std::vector<int> expected(count);
+        std::exclusive_scan(values.begin(), values.end(), expected.begin(), 3);
+
+        std::vector<int> result(count);
+        EXPECT_EQ(ParallelExclusiveScan(values.begin(), values.end(), result.begin(), 3, std::plus<>(), TEST_GRAIN),
+                  result.end());
+        EXPECT_EQ(result, expected);
+
+        ParallelExclusiveScan(values.begin(), values.end(), values.begin(), 3, std::plus<>(), TEST_GRAIN);
+        EXPECT_EQ(values, expected);
+    }
+}
+
+TEST(parallel_algorithms, stable_partition) {
+    auto is_even = [](const KeyValue& p_value) { return p_value.key % 2 == 0; };
+    for (size_t count : TEST_COUNTS) {
+        auto values = MakeKeyValues(count, 1000);
+        auto expected = values;
+        const auto expected_middle = std::stable_partition(expected.begin(), expected.end(), is_even);
+
+        const auto middle = ParallelStablePartition(values.begin(), values.end(), is_even, TEST_GRAIN);
+        EXPECT_EQ(middle - values.begin(), expected_middle - expected.begin());
+        EXPECT_EQ(values, expected);
+    }
+}
+
+TEST(parallel_algorithms, merge_sort) {
+    auto by_key = [](const KeyValue& p_lhs, const KeyValue& p_rhs) { return p_lhs.key < p_rhs.key; };
+    // few keys, lots of ties to check stability
+    for (uint32_t max_key : { 7u, 1000000u }) {
+        for (size_t count : TEST_COUNTS) {
+            auto values = MakeKeyValues(count, max_key);
+            auto expected = values;
+            std::stable_sort(expected.begin(), expected.end(), by_key);
+
+            ParallelMergeSort(values.begin(), values.end(), by_key, TEST_GRAIN);
+            EXPECT_EQ(values, expected);
+        }
+    }
+}
+
+TEST(parallel_algorithms, merge_sort_sorted_input) {
+    std::vector<int> ascending(5000);
+    std::iota(ascending.begin(), ascending.end(), 0);
+    std::vector<int> descending(ascending.rbegin(), ascending.rend());
+
+    ParallelMergeSort(descending.begin(), descending.end(), std::less<>(), TEST_GRAIN);
+    EXPECT_EQ(descending, ascending);
+    ParallelMergeSort(ascending.begin(), ascending.end(), std::greater<>(), TEST_GRAIN);
+    EXPECT_EQ(ascending.front(), 4999);
+    EXPECT_TRUE(std::is_sorted(ascending.begin(), ascending.end(), std::greater<>()));
+}
+
+TEST(parallel_algorithms, radix_sort) {
+    for (size_t count : TEST_COUNTS) {
+        std::mt19937_64 random(count);
+        std::vector<uint64_t> values(count);
+        for (auto& value : values) {
+            value = random();
+        }
+        auto expected = values;
+        std::sort(expected.begin(), expected.end());
+
+        ParallelRadixSort(values.begin(), values.end(), std::identity(), TEST_GRAIN);
+        EXPECT_EQ(values, expected);
+    }
+}
+
+TEST(parallel_algorithms, radix_sort_stable) {
+    auto get_key = [](const KeyValue& p_value) { return p_value.key; };
+    // small keys leave the high bytes equal, those passes get skipped
+    for (uint32_t max_key : { 0u, 255u, 70000u, 0xFFFFFFFFu }) {
+        for (size_t count : TEST_COUNTS) {
+            auto values = MakeKeyValues(count, max_key);
+            auto expected = values;
+            std::stable_sort(expected.begin(), expected.end(), [](const KeyValue& p_lhs, const KeyValue& p_rhs) {
+                return p_lhs.key < p_rhs.key;
+            });
+
+            ParallelRadixSort(values.begin(), values.end(), get_key, TEST_GRAIN);
+            EXPECT_EQ(values, expected);
+        }
+    }
+}
+
+}  // namespace my::jobsystem
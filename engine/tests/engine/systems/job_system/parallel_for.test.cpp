@@ -0,0 +1,61 @@
+#include "engine/systems/job_system/parallel_for.h"
+
+namespace my::jobsystem {
+
+TEST(parallel_for, visits_every_index_once) {
+    for (uint32_t count : { 1u, 7u, 1000u, 100000u }) {
+        std::vector<std::atomic_int> visits(count);
+
+        Context ctx;
+        ctx.Wait(ParallelFor(ctx, JobHandle(), count, [&visits](uint32_t p_index) {
+            visits[p_index].fetch_add(1);
+        }));
+
+        for (const auto& visit : visits) {
+            ASSERT_EQ(visit.load(), 1);
+        }
+    }
+}
+
+TEST(parallel_for, empty_range) {
+    Context ctx;
+    std::atomic_int calls = 0;
+    const JobHandle handle = ParallelFor(ctx, JobHandle(), 0, [&calls](uint32_t) { calls.fetch_add(1); });
+    EXPECT_TRUE(handle.IsDone());
+    EXPECT_EQ(calls.load(), 0);
+}
+
+TEST(parallel_for, grain) {
+    constexpr uint32_t COUNT = 1000;
+    std::vector<std::atomic_int> visits(COUNT);
+
+    Context ctx;
+    ParallelFor(ctx, JobHandle(), COUNT, [&visits](uint32_t p_index) { visits[p_index].fetch_add(1); }, 300);
+    ctx.Wait();
+
+    for (const auto& visit : visits) {
+        ASSERT_EQ(visit.load(), 1);
+    }
+}
+
+TEST(parallel_for, dependency) {
+    constexpr uint32_t COUNT = 4096;
+    std::vector<uint32_t> values(COUNT, 0);
+    std::atomic_int errors = 0;
+
+    Context ctx;
+    const JobHandle fill = ParallelFor(ctx, JobHandle(), COUNT, [&values](uint32_t p_index) {
+        values[p_index] = p_index;
+    });
+    // reads the neighbour written by the first pass
+    ParallelFor(ctx, fill, COUNT, [&values, &errors](uint32_t p_index) {
+        if (values[(p_index + 1) % COUNT] != (p_index + 1) % COUNT) {
+            errors.fetch_add(1);
+        }
+    });
+    ctx.Wait();
+
+    EXPECT_EQ(errors.load(), 0);
+}
+
+}  // namespace my::jobsystem
@@ -0,0 +1,60 @@
+#include "engine/systems/job_system/scratch_allocator.h"
+
+#include <numeric>
+
+#include "engine/systems/job_system/job_system.h"
+
+namespace my::jobsystem {
+
+TEST(scratch_allocator, nested_scopes) {
+    const size_t used = GetScratchArena().GetUsedSize();
+    {
+        ScratchScope outer;
+        ScratchVector<int> values(outer.GetArena());
+        values.reserve(100);
+        void* inner_memory = nullptr;
+        {
+            ScratchScope inner;
+            inner_memory = inner.GetArena().Allocate(1024);
+        }
+        {
+            ScratchScope inner;
+            EXPECT_EQ(inner.GetArena().Allocate(1024), inner_memory);
+        }
+        for (int i = 0; i < 100; ++i) {
+            values.push_back(i);
+        }
+        EXPECT_EQ(values[99], 99);
+    }
+    EXPECT_EQ(GetScratchArena().GetUsedSize(), used);
+}
+
+TEST(scratch_allocator, per_thread) {
+    LinearArena* main_arena = &GetScratchArena();
+    LinearArena* other_arena = nullptr;
+    std::thread thread([&]() { other_arena = &GetScratchArena(); });
+    thread.join();
+    EXPECT_NE(main_arena, other_arena);
+}
+
+TEST(scratch_allocator, job_bodies) {
+    constexpr uint32_t JOB_COUNT = 64;
+    std::array<int, JOB_COUNT> sums{};
+
+    Context ctx;
+    ctx.Dispatch(JOB_COUNT, 1, [&sums](JobArgs p_args) {
+        ScratchScope scratch;
+        ScratchVector<int> values(scratch.GetArena());
+        for (int i = 0; i <= static_cast<int>(p_args.jobIndex); ++i) {
+            values.push_back(i);
+        }
+        sums[p_args.jobIndex] = std::accumulate(values.begin(), values.end(), 0);
+    });
+    ctx.Wait();
+
+    for (uint32_t i = 0; i < JOB_COUNT; ++i) {
+        EXPECT_EQ(sums[i], static_cast<int>(i * (i + 1) / 2));
+    }
+}
+
+}  // namespace my::jobsystem
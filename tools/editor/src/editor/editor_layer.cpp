@@ -122,9 +122,12 @@ EditorLayer::EditorLayer() : Layer("EditorLayer") {
 void EditorLayer::OnAttach() {
     ImNodes::CreateContext();
 
+    static constexpr StringId s_play_icon("@res://images/icons/play.png");
+    static constexpr StringId s_pause_icon("@res://images/icons/pause.png");
+
     auto asset_registry = m_app->GetAssetRegistry();
-    m_playButtonImage = asset_registry->GetAssetByHandle<ImageAsset>(AssetHandle{ "@res://images/icons/play.png" });
-    m_pauseButtonImage = asset_registry->GetAssetByHandle<ImageAsset>(AssetHandle{ "@res://images/icons/pause.png" });
+    m_playButtonImage = asset_registry->GetAssetByHandle<ImageAsset>(AssetHandle{ s_play_icon });
+    m_pauseButtonImage = asset_registry->GetAssetByHandle<ImageAsset>(AssetHandle{ s_pause_icon });
 
     m_app->GetInputManager()->GetEventQueue().RegisterListener(this);
 
@@ -19,11 +19,16 @@ void ContentBrowser::OnAttach() {
     m_rootPath = fs::path{ path };
     m_currentPath = m_rootPath;
 
+    static constexpr StringId s_folder_icon("@res://images/icons/folder_icon.png");
+    static constexpr StringId s_image_icon("@res://images/icons/image_icon.png");
+    static constexpr StringId s_scene_icon("@res://images/icons/scene_icon.png");
+    static constexpr StringId s_meta_icon("@res://images/icons/meta_icon.png");
+
     auto asset_registry = m_editor.GetApplication()->GetAssetRegistry();
-    auto folder_icon = asset_registry->GetAssetByHandle<ImageAsset>(AssetHandle{ "@res://images/icons/folder_icon.png" });
-    auto image_icon = asset_registry->GetAssetByHandle<ImageAsset>(AssetHandle{ "@res://images/icons/image_icon.png" });
-    auto scene_icon = asset_registry->GetAssetByHandle<ImageAsset>(AssetHandle{ "@res://images/icons/scene_icon.png" });
-    auto meta_icon = asset_registry->GetAssetByHandle<ImageAsset>(AssetHandle{ "@res://images/icons/meta_icon.png" });
+    auto folder_icon = asset_registry->GetAssetByHandle<ImageAsset>(AssetHandle{ s_folder_icon });
+    auto image_icon = asset_registry->GetAssetByHandle<ImageAsset>(AssetHandle{ s_image_icon });
+    auto scene_icon = asset_registry->GetAssetByHandle<ImageAsset>(AssetHandle{ s_scene_icon });
+    auto meta_icon = asset_registry->GetAssetByHandle<ImageAsset>(AssetHandle{ s_meta_icon });
 
     m_iconMap["."] = { folder_icon, nullptr };
     m_iconMap[".png"] = { image_icon, nullptr };
@@ -76,7 +76,10 @@ void PropertyPanel::UpdateInternal(Scene& p_scene) {
         return;
     }
 
-    DrawInputText("Name", name_component->GetNameRef());
+    std::string name = name_component->GetName();
+    if (DrawInputText("Name", name)) {
+        name_component->SetName(name);
+    }
 
     ImGui::SameLine();
     ImGui::PushItemWidth(-1);
@@ -0,0 +1,89 @@
+#include <random>
+
+#include "engine/core/framework/engine.h"
+#include "engine/core/os/threads.h"
+#include "engine/core/os/timer.h"
+#include "engine/systems/job_system/parallel_algorithms.h"
+
+// Times the parallel algorithms against their std counterparts. Every case runs a few times on fresh input
+// and the fastest run is reported, usage: job_system_bench [job worker count]
+
+using namespace my;
+
+static constexpr int RUN_COUNT = 5;
+static constexpr size_t SIZES[] = { 1 << 14, 1 << 18, 1 << 22 };
+
+static std::vector<uint32_t> MakeInput(size_t p_count) {
+    std::mt19937 random(static_cast<uint32_t>(p_count));
+    std::vector<uint32_t> values(p_count);
+    for (uint32_t& value : values) {
+        value = random();
+    }
+    return values;
+}
+
+// p_func gets a copy of the input, so the sorts and partitions never see their own output
+template<typename FUNC>
+static double Measure(const std::vector<uint32_t>& p_input, FUNC&& p_func) {
+    double best = std::numeric_limits<double>::max();
+    for (int run = 0; run < RUN_COUNT; ++run) {
+        std::vector<uint32_t> values = p_input;
+        Timer timer;
+        p_func(values);
+        best = std::min(best, timer.GetDuration().ToMillisecond());
+    }
+    return best;
+}
+
+template<typename STD_FUNC, typename PARALLEL_FUNC>
+static void Compare(const char* p_name, size_t p_count, STD_FUNC&& p_std, PARALLEL_FUNC&& p_parallel) {
+    const std::vector<uint32_t> input = MakeInput(p_count);
+    const double std_ms = Measure(input, p_std);
+    const double parallel_ms = Measure(input, p_parallel);
+    PRINT("{:<18} {:>9} {:>10.3f} ms {:>10.3f} ms {:>7.2f}x", p_name, p_count, std_ms, parallel_ms, std_ms / parallel_ms);
+}
+
+int main(int p_argc, const char** p_argv) {
+    thread::ThreadConfig config;
+    if (p_argc > 1) {
+        config.jobWorkerCount = std::atoi(p_argv[1]);
+    }
+
+    engine::InitializeCore();
+    engine::InitializeThreads(config);
+
+    PRINT("{} job workers, best of {} runs", jobsystem::GetWorkerCount(), RUN_COUNT);
+    PRINT("{:<18} {:>9} {:>13} {:>13} {:>8}", "algorithm", "count", "std", "parallel", "speedup");
+
+    // the results go through here, so the work can't be optimized away
+    volatile uint64_t sink = 0;
+    auto is_even = [](uint32_t p_value) { return (p_value & 1) == 0; };
+
+    for (size_t count : SIZES) {
+        Compare(
+            "reduce", count,
+            [&](std::vector<uint32_t>& p_values) { sink = std::reduce(p_values.begin(), p_values.end(), uint64_t(0)); },
+            [&](std::vector<uint32_t>& p_values) { sink = jobsystem::ParallelReduce(p_values.begin(), p_values.end(), uint64_t(0)); });
+        Compare(
+            "inclusive scan", count,
+            [&](std::vector<uint32_t>& p_values) { std::inclusive_scan(p_values.begin(), p_values.end(), p_values.begin()); },
+            [&](std::vector<uint32_t>& p_values) { jobsystem::ParallelInclusiveScan(p_values.begin(), p_values.end(), p_values.begin()); });
+        Compare(
+            "stable partition", count,
+            [&](std::vector<uint32_t>& p_values) { std::stable_partition(p_values.begin(), p_values.end(), is_even); },
+            [&](std::vector<uint32_t>& p_values) { jobsystem::ParallelStablePartition(p_values.begin(), p_values.end(), is_even); });
+        Compare(
+            "merge sort", count,
+            [&](std::vector<uint32_t>& p_values) { std::stable_sort(p_values.begin(), p_values.end()); },
+            [&](std::vector<uint32_t>& p_values) { jobsystem::ParallelMergeSort(p_values.begin(), p_values.end()); });
+        // against std::sort, the fastest std sort, even though it isn't stable
+        Compare(
+            "radix sort", count,
+            [&](std::vector<uint32_t>& p_values) { std::sort(p_values.begin(), p_values.end()); },
+            [&](std::vector<uint32_t>& p_values) { jobsystem::ParallelRadixSort(p_values.begin(), p_values.end()); });
+    }
+
+    thread::RequestShutdown();
+    engine::FinalizeCore();
+    return 0;
+}
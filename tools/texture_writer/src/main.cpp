@@ -77,6 +77,7 @@ void WriteAviatorSkyImage(const char* p_file) {
 int main(int, const char**) {
     
     engine::InitializeCore();
+    engine::InitializeThreads();
 
     WriteImageWrapper("brdf.hdr", WriteBrdfImage);
 